@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include "./orizzonte/coroutine.hpp"
 #include "./orizzonte/meta.hpp"
 #include "./orizzonte/node.hpp"
+#include "./orizzonte/scheduler.hpp"
 #include "./orizzonte/utility.hpp"
 #include "./orizzonte/types.hpp"
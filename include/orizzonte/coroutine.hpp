@@ -0,0 +1,10 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+// Requires C++20 coroutines. Empty otherwise.
+#include "./coroutine/co_execute.hpp"
+#include "./coroutine/task.hpp"
+#include "./node/co_leaf.hpp"
@@ -0,0 +1,140 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine)
+
+#include "../scheduler/traits.hpp"
+#include "../utility/fwd.hpp"
+#include "../utility/maybe_atomic.hpp"
+#include "../utility/nothing.hpp"
+#include <coroutine>
+#include <optional>
+#include <type_traits>
+
+namespace orizzonte::coroutine
+{
+    /// @brief Awaitable that executes `Graph` when awaited, and resumes the
+    /// awaiting coroutine on the scheduler once every computation of the
+    /// graph completed.
+    /// @details The graph and its result are stored in the awaiter, which
+    /// lives in the frame of the awaiting coroutine: no allocation is
+    /// performed. If the graph completes before `execute` returns, the
+    /// coroutine is resumed immediately, without a scheduler round-trip.
+    template <typename Scheduler, typename Graph>
+    class graph_awaiter
+    {
+    private:
+        using graph_type = std::remove_reference_t<Graph>;
+        using out_type = typename graph_type::out_type;
+        using traits = orizzonte::scheduler::traits<Scheduler>;
+
+        static constexpr bool atomic = !traits::is_single_threaded;
+
+        Scheduler& _scheduler;
+        Graph _graph;
+        std::optional<out_type> _result;
+        std::coroutine_handle<> _handle;
+
+        // One count-down per cleanup, one for `then` and one for the end of
+        // `await_suspend`.
+        utility::maybe_atomic<int> _left;
+
+        void count_down()
+        {
+            if(_left.template fetch_sub<atomic>(1) == 1)
+            {
+                _scheduler([h = _handle] { h.resume(); });
+            }
+        }
+
+    public:
+        template <typename GraphFwd>
+        graph_awaiter(Scheduler& scheduler, GraphFwd&& graph)
+            : _scheduler{scheduler}, _graph{FWD(graph)}
+        {
+            _left.template store<atomic>(graph_type::cleanup_count() + 2);
+        }
+
+        graph_awaiter(const graph_awaiter&) = delete;
+        graph_awaiter& operator=(const graph_awaiter&) = delete;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            _handle = h;
+
+            _graph.execute(_scheduler, utility::nothing_v,
+                [this](auto&& out) {
+                    _result.emplace(FWD(out));
+                    count_down();
+                },
+                [this] { count_down(); });
+
+            // Completed inline: keep running on the current thread.
+            return _left.template fetch_sub<atomic>(1) != 1;
+        }
+
+        auto await_resume()
+        {
+            if constexpr(!utility::is_nothing_v<out_type>)
+            {
+                return std::move(*_result);
+            }
+        }
+    };
+
+    /// @brief Returns an awaitable that executes `graph` on `scheduler`.
+    /// `graph` is moved into the awaitable if it is an rvalue, and referenced
+    /// otherwise.
+    template <typename Scheduler, typename Graph>
+    auto co_execute(Scheduler& scheduler, Graph&& graph)
+    {
+        return graph_awaiter<Scheduler, Graph>{scheduler, FWD(graph)};
+    }
+
+    /// @brief Awaitable that suspends the awaiting coroutine and resumes it
+    /// on `Scheduler`.
+    template <typename Scheduler>
+    class schedule_awaiter
+    {
+    private:
+        Scheduler& _scheduler;
+
+    public:
+        explicit schedule_awaiter(Scheduler& scheduler) noexcept
+            : _scheduler{scheduler}
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            _scheduler([h] { h.resume(); });
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    /// @brief Returns an awaitable that moves the awaiting coroutine to
+    /// `scheduler`.
+    template <typename Scheduler>
+    auto resume_on(Scheduler& scheduler) noexcept
+    {
+        return schedule_awaiter<Scheduler>{scheduler};
+    }
+}
+
+#endif
@@ -0,0 +1,238 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine)
+
+#include "../utility/fwd.hpp"
+#include "../utility/nothing.hpp"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::coroutine
+{
+    template <typename T>
+    class task;
+
+    namespace detail
+    {
+        // Resumes the awaiting coroutine, if any, through symmetric transfer.
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<Promise> h) noexcept
+            {
+                return h.promise()._continuation;
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+
+        struct promise_base
+        {
+            std::coroutine_handle<> _continuation{std::noop_coroutine()};
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            final_awaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() const noexcept
+            {
+                std::terminate();
+            }
+        };
+
+        template <typename T>
+        struct promise : promise_base
+        {
+            std::optional<T> _value;
+
+            task<T> get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U&& x)
+            {
+                _value.emplace(FWD(x));
+            }
+
+            T take()
+            {
+                return std::move(*_value);
+            }
+        };
+
+        template <>
+        struct promise<void> : promise_base
+        {
+            task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept
+            {
+            }
+
+            void take() const noexcept
+            {
+            }
+        };
+    }
+
+    /// @brief Lazily-started coroutine producing a `T`. Awaiting a `task`
+    /// starts it, and resumes the awaiting coroutine when it completes.
+    template <typename T>
+    class task
+    {
+    public:
+        using value_type = T;
+        using promise_type = detail::promise<T>;
+
+    private:
+        std::coroutine_handle<promise_type> _handle;
+
+        struct awaiter
+        {
+            std::coroutine_handle<promise_type> _handle;
+
+            bool await_ready() const noexcept
+            {
+                return _handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> awaiting) noexcept
+            {
+                _handle.promise()._continuation = awaiting;
+                return _handle;
+            }
+
+            T await_resume()
+            {
+                return _handle.promise().take();
+            }
+        };
+
+    public:
+        explicit task(std::coroutine_handle<promise_type> handle) noexcept
+            : _handle{handle}
+        {
+        }
+
+        task(task&& rhs) noexcept : _handle{std::exchange(rhs._handle, {})}
+        {
+        }
+
+        task& operator=(task&& rhs) noexcept
+        {
+            if(this != &rhs)
+            {
+                if(_handle)
+                {
+                    _handle.destroy();
+                }
+
+                _handle = std::exchange(rhs._handle, {});
+            }
+
+            return *this;
+        }
+
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        ~task()
+        {
+            if(_handle)
+            {
+                _handle.destroy();
+            }
+        }
+
+        awaiter operator co_await() && noexcept
+        {
+            return awaiter{_handle};
+        }
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        task<T> promise<T>::get_return_object() noexcept
+        {
+            return task<T>{
+                std::coroutine_handle<promise<T>>::from_promise(*this)};
+        }
+
+        inline task<void> promise<void>::get_return_object() noexcept
+        {
+            return task<void>{
+                std::coroutine_handle<promise<void>>::from_promise(*this)};
+        }
+
+        // Eagerly-started coroutine that destroys itself on completion.
+        struct detached
+        {
+            struct promise_type
+            {
+                detached get_return_object() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                void return_void() const noexcept
+                {
+                }
+
+                void unhandled_exception() const noexcept
+                {
+                    std::terminate();
+                }
+            };
+        };
+
+        /// @brief Starts `t`, and invokes `then` with its result when it
+        /// completes. `void` results are passed as `nothing`.
+        template <typename T, typename Then>
+        detached start(task<T> t, Then then)
+        {
+            if constexpr(std::is_void_v<T>)
+            {
+                co_await std::move(t);
+                then(utility::nothing_v);
+            }
+            else
+            {
+                then(co_await std::move(t));
+            }
+        }
+    }
+}
+
+#endif
@@ -6,8 +6,26 @@
 
 #include "./node/all.hpp"
 #include "./node/any.hpp"
+#include "./node/async_leaf.hpp"
+#include "./node/batcher.hpp"
+#include "./node/choose.hpp"
+#include "./node/co_leaf.hpp"
+#include "./node/cost.hpp"
+#include "./node/fan_out.hpp"
+#include "./node/file.hpp"
 #include "./node/helper.hpp"
+#include "./node/incremental.hpp"
+#include "./node/io.hpp"
 #include "./node/leaf.hpp"
+#include "./node/limit.hpp"
+#include "./node/memo.hpp"
+#include "./node/on.hpp"
+#include "./node/pipeline.hpp"
+#include "./node/repeat_until.hpp"
 #include "./node/seq.hpp"
+#include "./node/shared.hpp"
+#include "./node/single_flight.hpp"
+#include "./node/when_each.hpp"
+#include "./node/with_priority.hpp"
 
 #include "./node/then.inl"
@@ -5,32 +5,37 @@
 #pragma once
 
 #include "../meta/enumerate_args.hpp"
+#include "../scheduler/traits.hpp"
 #include "../utility/aligned_storage.hpp"
 #include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/maybe_atomic.hpp"
 #include "./helper.hpp"
-#include <atomic>
+#include <algorithm>
+#include <tuple>
 #include <type_traits>
 
 namespace orizzonte::node
 {
     template <typename... Fs>
-    class all : Fs...
+    class all : detail::children_of<Fs...>
     {
     public:
         using in_type = std::common_type_t<typename Fs::in_type...>;
         using out_type = utility::cache_aligned_tuple<typename Fs::out_type...>;
 
     private:
+        using children = detail::children_of<Fs...>;
+
         struct shared_state
         {
             ORIZZONTE_CACHE_ALIGNED in_type _input;
-            ORIZZONTE_CACHE_ALIGNED std::atomic<int> _left;
+            ORIZZONTE_CACHE_ALIGNED utility::maybe_atomic<int> _left;
 
-            template <typename Input>
-            shared_state(Input&& input) : _input{FWD(input)}
+            template <bool Atomic, typename Input>
+            shared_state(std::bool_constant<Atomic>, Input&& input)
+                : _input{FWD(input)}
             {
-                // `std::atomic` construction is not atomic.
-                _left.store(sizeof...(Fs), std::memory_order_release);
+                _left.template store<Atomic>(sizeof...(Fs));
             }
         };
 
@@ -40,7 +45,7 @@ namespace orizzonte::node
         ORIZZONTE_CACHE_ALIGNED out_type _values;
 
     public:
-        constexpr all(Fs&&... fs) : Fs{std::move(fs)}...
+        constexpr all(Fs&&... fs) : children{std::move(fs)...}
         {
         }
 
@@ -49,35 +54,56 @@ namespace orizzonte::node
         void execute(Scheduler& scheduler, Input&& input, Then&& then,
             Cleanup&& cleanup) &
         {
+            // Synchronous children of a node executed by a single-threaded
+            // scheduler can never complete concurrently: a plain counter is
+            // enough.
+            constexpr bool atomic =
+                !orizzonte::scheduler::traits<Scheduler>::is_single_threaded ||
+                !synchronous();
+
             // TODO: don't construct/destroy if lvalue?
-            _state.construct(FWD(input));
-
-            meta::enumerate_types<Fs...>([&](auto i, auto t) {
-                auto& f = static_cast<meta::unwrap<decltype(t)>&>(*this);
-                auto computation = [this, &scheduler, &f, then,
-                                       cleanup /* TODO: fwd capture */] {
-                    f.execute(scheduler, _state->_input,
-                        [this, then](auto&& out) {
-                            utility::get<decltype(i){}>(_values) = FWD(out);
-
-                            if(_state->_left.fetch_sub(
-                                   1, std::memory_order_acq_rel) == 1)
-                            {
-                                _state.destroy();
-                                then(std::move(_values));
-
-                                // Invoking `cleanup` is not required here
-                                // as there is only one deterministic clear
-                                // path that can be taken. The `then` itself
-                                // can take care of the cleanup step.
-                            }
-                        },
-                        cleanup);
-                };
-
-                detail::schedule_if_last<Fs...>(
-                    i, scheduler, std::move(computation));
-            });
+            _state.construct(std::bool_constant<atomic>{}, FWD(input));
+
+            // A single computation executes any of the children, given its
+            // index, so that bulk submissions share one copy of it.
+            auto run = [this, &scheduler, then,
+                           cleanup /* TODO: fwd capture */](auto i) {
+                auto& f = this->template child<decltype(i){}>();
+
+                f.execute(scheduler, _state->_input,
+                    [this, then](auto&& out) {
+                        utility::get<decltype(i){}>(_values) = FWD(out);
+
+                        if(_state->_left.template fetch_sub<atomic>(1) == 1)
+                        {
+                            _state.destroy();
+                            then(std::move(_values));
+
+                            // Invoking `cleanup` is not required here as
+                            // there is only one deterministic clear path
+                            // that can be taken. The `then` itself can take
+                            // care of the cleanup step.
+                        }
+                    },
+                    cleanup);
+            };
+
+            detail::execute_by_plan<Fs...>(scheduler, std::move(run));
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return std::max({detail::cost_of<Fs>()...});
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return std::max({detail::inline_depth_of<Fs>()...}) + 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return (detail::synchronous_of<Fs>() && ...);
         }
 
         static constexpr std::size_t cleanup_count() noexcept
@@ -0,0 +1,126 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../scheduler/traits.hpp"
+#include "../utility/fwd.hpp"
+#include "../utility/noop.hpp"
+#include "../utility/nothing.hpp"
+#include "./helper.hpp"
+#include <type_traits>
+
+namespace orizzonte::node
+{
+    /// @brief Handle used to complete an `async_leaf` with a value of type
+    /// `Out`. Stores the continuation of the leaf by value.
+    /// @details Must be invoked exactly once, from any thread. Invoking it
+    /// executes the rest of the graph on the invoking thread, or submits it
+    /// to the scheduler if the scheduler is single-threaded.
+    template <typename Out, typename Then>
+    class completion
+    {
+    private:
+        Then _then;
+
+    public:
+        template <typename ThenFwd>
+        explicit completion(ThenFwd&& then) : _then{FWD(then)}
+        {
+        }
+
+        /// @brief Completes the leaf with `Out{xs...}`.
+        template <typename... Ts>
+        void operator()(Ts&&... xs)
+        {
+            _then(Out{FWD(xs)...});
+        }
+    };
+
+    /// @brief Leaf whose result is produced asynchronously.
+    /// @details `F` is invoked with the input of the leaf (if any) and with a
+    /// `completion` handle, and is expected to start some work and return.
+    /// The leaf completes when the handle is invoked, e.g. from an external
+    /// event source, without holding a worker in the meantime.
+    template <typename In, typename Out, typename F>
+    struct async_leaf : F
+    {
+    public:
+        using in_type = In;
+        using out_type = Out;
+
+        constexpr async_leaf(detail::out_t<Out>, F&& f) : F{std::move(f)}
+        {
+        }
+
+        constexpr async_leaf(detail::in_t<In>, detail::out_t<Out>, F&& f)
+            : F{std::move(f)}
+        {
+        }
+
+    private:
+        template <typename Input, typename Then>
+        void start(Input&& input, Then&& then)
+        {
+            completion<Out, std::decay_t<Then>> done{FWD(then)};
+
+            if constexpr(utility::is_nothing_v<In>)
+            {
+                static_cast<F&>(*this)(std::move(done));
+            }
+            else
+            {
+                static_cast<F&>(*this)(FWD(input), std::move(done));
+            }
+        }
+
+    public:
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input,
+            Then&& then = utility::noop_v, Cleanup&& = utility::noop_v) &
+        {
+            using traits = orizzonte::scheduler::traits<Scheduler>;
+
+            if constexpr(traits::is_single_threaded && !traits::is_inline)
+            {
+                // The other nodes of the graph do not synchronize with each
+                // other, and must keep executing on the scheduler's thread.
+                start(FWD(input),
+                    [&scheduler, then = FWD(then)](auto&& out) mutable {
+                        scheduler(
+                            [t = std::move(then), o = FWD(out)]() mutable {
+                                t(std::move(o));
+                            });
+                    });
+            }
+            else
+            {
+                start(FWD(input), FWD(then));
+            }
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return false;
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return 0;
+        }
+    };
+
+    template <typename Out, typename F>
+    async_leaf(detail::out_t<Out>, F)->async_leaf<utility::nothing, Out, F>;
+
+    template <typename In, typename Out, typename F>
+    async_leaf(detail::in_t<In>, detail::out_t<Out>, F)
+        ->async_leaf<In, Out, F>;
+}
@@ -0,0 +1,319 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/aligned_storage.hpp"
+#include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/task.hpp"
+#include "./helper.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace orizzonte::node
+{
+    template <typename In, typename F>
+    class batcher_ref;
+
+    /// @brief Coalesces the inputs of concurrent executions of `ref()` nodes
+    /// into batches, and invokes `F` once per batch. `F` receives a
+    /// `std::vector<In>` and must return a `std::vector` with one result per
+    /// input, in the same order. Declared outside of the graphs, which refer
+    /// to it through the nodes returned by `ref()`.
+    /// @details Inputs are buffered in shards selected by the submitting
+    /// thread, so that concurrent executions rarely contend on the same
+    /// mutex. A shard is flushed by the execution filling it up to the size
+    /// limit, or by a timer thread once its oldest input waited for the time
+    /// window. Every result is then delivered to the continuation of its
+    /// execution through the scheduler that execution was started on.
+    /// Buffered inputs are flushed on destruction.
+    template <typename In, typename F>
+    class batcher : F
+    {
+        friend class batcher_ref<In, F>;
+
+    public:
+        using in_type = In;
+        using out_type = typename std::invoke_result_t<F&,
+            std::vector<In>&&>::value_type;
+
+        using clock = std::chrono::steady_clock;
+
+    private:
+        struct waiter
+        {
+            utility::aligned_storage_for<out_type>* _slot;
+            utility::task _resume;
+        };
+
+        struct ORIZZONTE_CACHE_ALIGNED shard
+        {
+            std::mutex _mutex;
+            std::vector<In> _inputs;
+            std::vector<waiter> _waiters;
+            clock::time_point _deadline;
+        };
+
+        struct batch
+        {
+            std::vector<In> _inputs;
+            std::vector<waiter> _waiters;
+        };
+
+        std::size_t _max_size;
+        clock::duration _window;
+        std::size_t _shard_count;
+        std::unique_ptr<shard[]> _shards;
+
+        std::mutex _timer_mutex;
+        std::condition_variable _timer_cv;
+        bool _wake{false};
+        bool _stop{false};
+        std::thread _timer;
+
+        shard& current_shard() noexcept
+        {
+            const auto h = std::hash<std::thread::id>{}(
+                std::this_thread::get_id());
+
+            return _shards[h % _shard_count];
+        }
+
+        // Must be invoked with the mutex of `s` locked.
+        batch take(shard& s)
+        {
+            batch result{std::move(s._inputs), std::move(s._waiters)};
+
+            s._inputs.clear();
+            s._inputs.reserve(_max_size);
+            s._waiters.clear();
+            s._waiters.reserve(_max_size);
+
+            return result;
+        }
+
+        void run(batch&& b)
+        {
+            const auto n = b._waiters.size();
+            auto outs = static_cast<F&>(*this)(std::move(b._inputs));
+            assert(outs.size() == n);
+
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                b._waiters[i]._slot->construct(std::move(outs[i]));
+                b._waiters[i]._resume();
+            }
+        }
+
+        void submit(In&& input, utility::aligned_storage_for<out_type>& slot,
+            utility::task&& resume)
+        {
+            auto& s = current_shard();
+            batch b;
+            bool opened;
+
+            {
+                std::lock_guard g{s._mutex};
+
+                opened = s._inputs.empty();
+                if(opened)
+                {
+                    s._deadline = clock::now() + _window;
+                }
+
+                s._inputs.emplace_back(std::move(input));
+                s._waiters.push_back(waiter{&slot, std::move(resume)});
+
+                if(s._inputs.size() >= _max_size)
+                {
+                    b = take(s);
+                }
+            }
+
+            if(!b._waiters.empty())
+            {
+                run(std::move(b));
+            }
+            else if(opened)
+            {
+                std::lock_guard g{_timer_mutex};
+                _wake = true;
+                _timer_cv.notify_one();
+            }
+        }
+
+        /// @brief Flushes the shards whose deadline expired, and returns the
+        /// earliest deadline of the others.
+        clock::time_point flush_expired()
+        {
+            auto next = clock::time_point::max();
+
+            for(std::size_t i = 0; i < _shard_count; ++i)
+            {
+                auto& s = _shards[i];
+                batch b;
+
+                {
+                    std::lock_guard g{s._mutex};
+                    if(s._inputs.empty())
+                    {
+                        continue;
+                    }
+
+                    if(s._deadline > clock::now())
+                    {
+                        next = std::min(next, s._deadline);
+                        continue;
+                    }
+
+                    b = take(s);
+                }
+
+                run(std::move(b));
+            }
+
+            return next;
+        }
+
+        void timer_loop()
+        {
+            std::unique_lock l{_timer_mutex};
+
+            while(!_stop)
+            {
+                _wake = false;
+
+                l.unlock();
+                const auto next = flush_expired();
+                l.lock();
+
+                const auto woken = [this] { return _stop || _wake; };
+
+                if(next == clock::time_point::max())
+                {
+                    _timer_cv.wait(l, woken);
+                }
+                else
+                {
+                    _timer_cv.wait_until(l, next, woken);
+                }
+            }
+        }
+
+    public:
+        template <typename Rep, typename Period>
+        batcher(detail::in_t<In>, std::size_t max_size,
+            std::chrono::duration<Rep, Period> window, F&& f,
+            std::size_t shards = std::thread::hardware_concurrency())
+            : F{std::move(f)}, _max_size{std::max(max_size, std::size_t(1))},
+              _window{std::chrono::duration_cast<clock::duration>(window)},
+              _shard_count{std::max(shards, std::size_t(1))},
+              _shards{std::make_unique<shard[]>(_shard_count)}
+        {
+            for(std::size_t i = 0; i < _shard_count; ++i)
+            {
+                _shards[i]._inputs.reserve(_max_size);
+                _shards[i]._waiters.reserve(_max_size);
+            }
+
+            _timer = std::thread{[this] { timer_loop(); }};
+        }
+
+        batcher(const batcher&) = delete;
+        batcher& operator=(const batcher&) = delete;
+
+        ~batcher()
+        {
+            {
+                std::lock_guard g{_timer_mutex};
+                _stop = true;
+                _timer_cv.notify_one();
+            }
+
+            _timer.join();
+
+            for(std::size_t i = 0; i < _shard_count; ++i)
+            {
+                if(!_shards[i]._inputs.empty())
+                {
+                    run(take(_shards[i]));
+                }
+            }
+        }
+
+        /// @brief Returns a node submitting its input to this batcher, and
+        /// completing with the corresponding result. The `batcher` object
+        /// must outlive it.
+        batcher_ref<In, F> ref() noexcept
+        {
+            return batcher_ref<In, F>{*this};
+        }
+    };
+
+    template <typename In, typename Rep, typename Period, typename F>
+    batcher(detail::in_t<In>, std::size_t, std::chrono::duration<Rep, Period>,
+        F)
+        ->batcher<In, F>;
+
+    template <typename In, typename Rep, typename Period, typename F>
+    batcher(detail::in_t<In>, std::size_t, std::chrono::duration<Rep, Period>,
+        F, std::size_t)
+        ->batcher<In, F>;
+
+    /// @brief Node executing its input as part of a batch of a `batcher`.
+    template <typename In, typename F>
+    class batcher_ref
+    {
+        friend class batcher<In, F>;
+
+    public:
+        using in_type = In;
+        using out_type = typename batcher<In, F>::out_type;
+
+    private:
+        batcher<In, F>* _batcher;
+        utility::aligned_storage_for<out_type> _result;
+
+        explicit batcher_ref(batcher<In, F>& b) noexcept : _batcher{&b}
+        {
+        }
+
+    public:
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(
+            Scheduler& scheduler, Input&& input, Then&& then, Cleanup&&) &
+        {
+            _batcher->submit(In(FWD(input)), _result,
+                utility::task{[this, &scheduler, then] {
+                    detail::schedule_if<false>(scheduler, [this, then] {
+                        // The node can be executed again from `then`.
+                        out_type r{std::move(*_result)};
+                        _result.destroy();
+                        then(std::move(r));
+                    });
+                }});
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return false;
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return 0;
+        }
+    };
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../meta/type_wrapper.hpp"
+#include "../types/variant.hpp"
+#include "../utility/nothing.hpp"
+#include "./helper.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::node::detail
+{
+    /// @brief Evaluates to `T` if every type in `T, Ts...` is `T`, otherwise
+    /// to `variant<T, Ts...>`.
+    template <typename T, typename... Ts>
+    struct unified
+        : meta::type<std::conditional_t<(std::is_same_v<T, Ts> && ...), T,
+              orizzonte::variant<T, Ts...>>>
+    {
+    };
+
+    template <typename... Ts>
+    using unified_t = typename unified<Ts...>::type;
+}
+
+namespace orizzonte::node
+{
+    /// @brief Invokes `Selector` on its input, and executes only the child in
+    /// `Fs...` whose index it returns, with the same input. Completes with the
+    /// result of the chosen child: if every child has the same output type,
+    /// it is forwarded unchanged, otherwise it is wrapped in a `variant`.
+    /// Out-of-range indices, including negative ones, select the last child,
+    /// which acts as the default branch.
+    /// @details The chosen child is executed directly from `execute`, on the
+    /// current thread, without going through the scheduler. The cleanups of
+    /// the children that are not taken are invoked before it starts.
+    template <typename Selector, typename... Fs>
+    class choose : detail::children_of<Fs...>
+    {
+    public:
+        using in_type = std::common_type_t<typename Fs::in_type...>;
+        using out_type = detail::unified_t<typename Fs::out_type...>;
+
+    private:
+        using children = detail::children_of<Fs...>;
+
+        static constexpr bool forwards_output =
+            std::is_same_v<out_type, std::tuple_element_t<0,
+                                         std::tuple<typename Fs::out_type...>>>;
+
+        static constexpr std::array<std::size_t, sizeof...(Fs)>
+            cleanup_counts{Fs::cleanup_count()...};
+
+        Selector _selector;
+
+        template <std::size_t I, typename Scheduler, typename Input,
+            typename Then, typename Cleanup>
+        void run(Scheduler& scheduler, Input&& input, Then& then,
+            Cleanup& cleanup)
+        {
+            for(std::size_t j = 0; j < sizeof...(Fs); ++j)
+            {
+                for(std::size_t k = 0; j != I && k < cleanup_counts[j]; ++k)
+                {
+                    cleanup();
+                }
+            }
+
+            auto& f = this->template child<I>();
+
+            if constexpr(forwards_output)
+            {
+                f.execute(scheduler, FWD(input), then, cleanup);
+            }
+            else
+            {
+                f.execute(scheduler, FWD(input),
+                    [then](auto&& out) { then(out_type{FWD(out)}); },
+                    cleanup);
+            }
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup, std::size_t... Is>
+        void dispatch(std::size_t i, std::index_sequence<Is...>,
+            Scheduler& scheduler, Input&& input, Then& then, Cleanup& cleanup)
+        {
+            ((i == Is ? run<Is>(scheduler, FWD(input), then, cleanup)
+                      : void()),
+                ...);
+        }
+
+    public:
+        constexpr choose(Selector&& selector, Fs&&... fs)
+            : children{std::move(fs)...}, _selector{std::move(selector)}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&& cleanup) &
+        {
+            const std::size_t i = std::min(
+                static_cast<std::size_t>(utility::call_ignoring_nothing(
+                    _selector, std::as_const(input))),
+                sizeof...(Fs) - 1);
+
+            dispatch(i, std::index_sequence_for<Fs...>{}, scheduler,
+                FWD(input), then, cleanup);
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return std::max({detail::cost_of<Fs>()...});
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return std::max({detail::inline_depth_of<Fs>()...}) + 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return (detail::synchronous_of<Fs>() && ...);
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return (Fs::cleanup_count() + ...);
+        }
+    };
+
+    template <typename Selector, typename... Fs>
+    choose(Selector, Fs...)->choose<Selector, Fs...>;
+}
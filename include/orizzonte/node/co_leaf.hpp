@@ -0,0 +1,95 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine)
+
+#include "../coroutine/task.hpp"
+#include "../utility/noop.hpp"
+#include "../utility/nothing.hpp"
+#include "./cost.hpp"
+#include "./helper.hpp"
+#include <type_traits>
+
+namespace orizzonte::node
+{
+    /// @brief Leaf whose body is a coroutine returning a `coroutine::task`.
+    /// @details The body can suspend, e.g. waiting for I/O or a timer,
+    /// without blocking the worker that started it. The node completes when
+    /// the task does, on the thread that resumed it. Parameters of the body
+    /// should be taken by value, as the input does not outlive `execute`.
+    template <typename In, typename F, std::size_t Cost = normal>
+    struct co_leaf : F
+    {
+    public:
+        using in_type = In;
+        using task_type = utility::result_of_ignoring_nothing_t<F&, in_type>;
+        using out_type =
+            utility::void_to_nothing_t<typename task_type::value_type>;
+
+        constexpr co_leaf(F&& f) : F{std::move(f)}
+        {
+        }
+
+        constexpr co_leaf(detail::in_t<In>, F&& f) : co_leaf{std::move(f)}
+        {
+        }
+
+        constexpr co_leaf(detail::cost_tag<Cost>, F&& f)
+            : co_leaf{std::move(f)}
+        {
+        }
+
+        constexpr co_leaf(detail::in_t<In>, detail::cost_tag<Cost>, F&& f)
+            : co_leaf{std::move(f)}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler&, Input&& input, Then&& then = utility::noop_v,
+            Cleanup&& = utility::noop_v) &
+        {
+            coroutine::detail::start(
+                utility::call_ignoring_nothing(*this, FWD(input)), FWD(then));
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return Cost;
+        }
+
+        // `then` might be invoked from another thread, after suspension.
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return false;
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return 0;
+        }
+    };
+
+    template <typename F>
+    co_leaf(F)->co_leaf<detail::first_arg_t<decltype(&F::operator())>, F>;
+
+    template <typename In, typename F>
+    co_leaf(detail::in_t<In>, F)->co_leaf<In, F>;
+
+    template <std::size_t Cost, typename F>
+    co_leaf(detail::cost_tag<Cost>, F)
+        ->co_leaf<detail::first_arg_t<decltype(&F::operator())>, F, Cost>;
+
+    template <typename In, std::size_t Cost, typename F>
+    co_leaf(detail::in_t<In>, detail::cost_tag<Cost>, F)->co_leaf<In, F, Cost>;
+}
+
+#endif
@@ -0,0 +1,59 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <cstddef>
+#include <experimental/type_traits>
+#include <utility>
+
+namespace orizzonte::node
+{
+    /// @brief Cost hint for computations that are cheaper than a scheduler
+    /// round-trip. Trivial children of `all`/`any` are always executed inline.
+    inline constexpr std::size_t trivial = 0;
+
+    /// @brief Cost hint for cheap computations.
+    inline constexpr std::size_t light = 1;
+
+    /// @brief Default cost hint.
+    inline constexpr std::size_t normal = 8;
+
+    /// @brief Cost hint for expensive computations, which are submitted first.
+    inline constexpr std::size_t heavy = 64;
+}
+
+namespace orizzonte::node::detail
+{
+    template <std::size_t C>
+    struct cost_tag
+    {
+    };
+
+    template <typename T>
+    using cost_impl = decltype(T::cost());
+
+    /// @brief Estimated cost of executing `T`. Nodes that do not provide a
+    /// `cost()` static member function are assumed to be `normal`.
+    template <typename T>
+    constexpr std::size_t cost_of() noexcept
+    {
+        if constexpr(std::experimental::is_detected_v<cost_impl, T>)
+        {
+            return T::cost();
+        }
+        else
+        {
+            return normal;
+        }
+    }
+}
+
+namespace orizzonte::node
+{
+    /// @brief Tag used to attach a compile-time cost hint to a `leaf`, e.g.
+    /// `leaf{cost<heavy>, f}`.
+    template <std::size_t C>
+    inline constexpr detail::cost_tag<C> cost{};
+}
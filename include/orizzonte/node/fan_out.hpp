@@ -0,0 +1,150 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../scheduler/traits.hpp"
+#include "../utility/aligned_storage.hpp"
+#include "../utility/maybe_atomic.hpp"
+#include "../utility/nothing.hpp"
+#include "./helper.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace orizzonte::node
+{
+    /// @brief Applies `F` in parallel to every element of its input, a
+    /// random-access range whose size is only known at run-time. Outputs a
+    /// `std::vector` of the results, in the same order.
+    /// @details Uses `scheduler.bulk` when available. The last element is
+    /// processed inline. Elements are passed to `F` as obtained from the
+    /// range, so views over the input are never copied. The input is moved
+    /// out of the node and kept alive until the continuation returns: results
+    /// referring to storage owned through it (e.g. the elements of a
+    /// `std::vector`) can be consumed synchronously.
+    template <typename Range, typename F>
+    class fan_out : F
+    {
+    public:
+        using in_type = Range;
+        using element_type =
+            decltype(std::declval<const Range&>()[std::size_t{}]);
+        using out_type = std::vector<
+            utility::result_of_ignoring_nothing_t<F&, element_type>>;
+
+    private:
+        using value_type = typename out_type::value_type;
+
+        // `std::vector<bool>` packs its elements, and cannot be written
+        // concurrently: boolean results are stored one per byte instead.
+        using buffer_type = std::conditional_t<std::is_same_v<value_type, bool>,
+            std::vector<unsigned char>, out_type>;
+
+        struct shared_state
+        {
+            Range _input;
+            buffer_type _results;
+            utility::maybe_atomic<std::size_t> _left;
+
+            template <bool Atomic, typename Input>
+            shared_state(std::bool_constant<Atomic>, Input&& input)
+                : _input{FWD(input)}
+            {
+                _results.resize(_input.size());
+                _left.template store<Atomic>(_input.size());
+            }
+        };
+
+        utility::aligned_storage_for<shared_state> _state;
+
+        static out_type to_output(buffer_type&& buffer)
+        {
+            if constexpr(std::is_same_v<buffer_type, out_type>)
+            {
+                return std::move(buffer);
+            }
+            else
+            {
+                return out_type(buffer.begin(), buffer.end());
+            }
+        }
+
+    public:
+        constexpr fan_out(detail::in_t<Range>, F&& f) : F{std::move(f)}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&&) &
+        {
+            using traits = orizzonte::scheduler::traits<Scheduler>;
+            constexpr bool atomic = !traits::is_single_threaded;
+
+            _state.construct(std::bool_constant<atomic>{}, FWD(input));
+
+            const std::size_t n = _state->_input.size();
+            if(n == 0)
+            {
+                out_type results;
+                _state.destroy();
+                then(std::move(results));
+                return;
+            }
+
+            auto run = [this, then](std::size_t i) mutable {
+                auto& s = *_state;
+                s._results[i] = utility::call_ignoring_nothing(
+                    static_cast<F&>(*this), s._input[i]);
+
+                if(s._left.template fetch_sub<atomic>(1) == 1)
+                {
+                    Range input{std::move(s._input)};
+                    out_type results = to_output(std::move(s._results));
+                    _state.destroy();
+                    then(std::move(results));
+                }
+            };
+
+            if constexpr(traits::supports_bulk)
+            {
+                if(n > 1 && orizzonte::scheduler::should_spawn(scheduler))
+                {
+                    scheduler.bulk(n - 1, run);
+                    run(n - 1);
+                    return;
+                }
+            }
+
+            for(std::size_t i = 0; i < n - 1; ++i)
+            {
+                detail::schedule_if<false>(
+                    scheduler, [run, i]() mutable { run(i); });
+            }
+
+            run(n - 1);
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return true;
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return 0;
+        }
+    };
+
+    template <typename Range, typename F>
+    fan_out(detail::in_t<Range>, F)->fan_out<Range, F>;
+}
@@ -0,0 +1,33 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#if defined(__unix__)
+
+#include "../utility/chunked_file.hpp"
+#include "../utility/mapped_file.hpp"
+#include "./leaf.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace orizzonte::node
+{
+    /// @brief Source leaf that maps the file at `path` and outputs it as a
+    /// `utility::chunked_file`, split into chunks of roughly `chunk_size`
+    /// bytes at `delimiter` boundaries. Meant to be followed by a `fan_out`.
+    /// @details Failures result in an empty output. See
+    /// `utility::mapped_file::error()`.
+    inline auto file_chunks(
+        std::string path, std::size_t chunk_size, char delimiter = '\n')
+    {
+        return leaf{[path = std::move(path), chunk_size, delimiter] {
+            return utility::chunked_file{
+                utility::mapped_file{path.c_str()}, chunk_size, delimiter};
+        }};
+    }
+}
+
+#endif
@@ -4,10 +4,16 @@
 
 #pragma once
 
+#include "../meta/constant.hpp"
 #include "../meta/type_wrapper.hpp"
+#include "../scheduler/traits.hpp"
 #include "../utility/nothing.hpp"
+#include "./cost.hpp"
+#include <algorithm>
+#include <array>
 #include <boost/callable_traits.hpp>
 #include <experimental/type_traits>
+#include <tuple>
 #include <utility>
 
 namespace orizzonte::node::detail
@@ -17,6 +23,11 @@ namespace orizzonte::node::detail
     {
     };
 
+    template <typename T>
+    struct out_t
+    {
+    };
+
     template <bool B, typename Scheduler, typename F>
     void schedule_if(Scheduler& scheduler, F&& f)
     {
@@ -24,6 +35,13 @@ namespace orizzonte::node::detail
         {
             FWD(f)();
         }
+        else if(!orizzonte::scheduler::should_spawn(scheduler))
+        {
+            // Lazy task creation: when no worker would pick the computation
+            // up sooner than the current thread, run it inline instead of
+            // paying for a queue round-trip.
+            FWD(f)();
+        }
         else
         {
             // The computation has to be moved here as it will die at
@@ -32,11 +50,250 @@ namespace orizzonte::node::detail
         }
     }
 
+    /// @brief Base storing the `I`-th child `F` of a parallel node. Allows
+    /// equal children, e.g. two identical I/O leaves, to be distinct bases.
+    template <std::size_t I, typename F>
+    struct indexed_child : F
+    {
+        constexpr indexed_child(F&& f) : F{std::move(f)}
+        {
+        }
+    };
+
+    template <typename Is, typename... Fs>
+    class indexed_children;
+
+    /// @brief Stores the children `Fs...` of a parallel node as empty-base
+    /// optimized bases, accessible by index.
+    template <std::size_t... Is, typename... Fs>
+    class indexed_children<std::index_sequence<Is...>, Fs...>
+        : indexed_child<Is, Fs>...
+    {
+    public:
+        constexpr indexed_children(Fs&&... fs)
+            : indexed_child<Is, Fs>{std::move(fs)}...
+        {
+        }
+
+        template <std::size_t I>
+        auto& child() noexcept
+        {
+            using type = std::tuple_element_t<I, std::tuple<Fs...>>;
+            return static_cast<type&>(
+                static_cast<indexed_child<I, type>&>(*this));
+        }
+    };
+
+    template <typename... Fs>
+    using children_of =
+        indexed_children<std::index_sequence_for<Fs...>, Fs...>;
+
+    /// @brief Compile-time plan deciding the order in which the children
+    /// `Xs...` of a parallel node are started, and which of them are executed
+    /// inline.
+    /// @details The most expensive child (the last one, between equally
+    /// expensive children) is executed inline, after every other child was
+    /// started. The remaining children are submitted to the scheduler by
+    /// descending cost, except `trivial` ones, which are executed inline
+    /// right before the most expensive one.
+    template <typename... Xs>
+    struct execution_plan
+    {
+        static constexpr std::size_t count = sizeof...(Xs);
+
+        static constexpr std::array<std::size_t, count> costs{
+            cost_of<Xs>()...};
+
+        static constexpr std::size_t inline_index = [] {
+            std::size_t result = 0;
+            for(std::size_t i = 1; i < count; ++i)
+            {
+                if(costs[i] >= costs[result])
+                {
+                    result = i;
+                }
+            }
+
+            return result;
+        }();
+
+        static constexpr bool runs_inline(std::size_t i) noexcept
+        {
+            return i == inline_index || costs[i] == trivial;
+        }
+
+        /// @brief Number of children submitted to the scheduler. They are
+        /// the first `scheduled_count` entries of `order`.
+        static constexpr std::size_t scheduled_count = [] {
+            std::size_t result = 0;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                result += !runs_inline(i);
+            }
+
+            return result;
+        }();
+
+        static constexpr std::array<std::size_t, count> order = [] {
+            std::array<std::size_t, count> result{};
+            std::size_t n = 0;
+
+            // Scheduled children, by descending cost. Stable, so that equally
+            // expensive children are started in declaration order.
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                if(runs_inline(i))
+                {
+                    continue;
+                }
+
+                std::size_t j = n++;
+                for(; j > 0 && costs[result[j - 1]] < costs[i]; --j)
+                {
+                    result[j] = result[j - 1];
+                }
+
+                result[j] = i;
+            }
+
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                if(i != inline_index && costs[i] == trivial)
+                {
+                    result[n++] = i;
+                }
+            }
+
+            result[n] = inline_index;
+            return result;
+        }();
+    };
+
+    template <typename... Xs, typename F, std::size_t... Ks>
+    void enumerate_by_plan_impl(std::index_sequence<Ks...>, F&& f)
+    {
+        using plan = execution_plan<Xs...>;
+        using types = std::tuple<Xs...>;
+
+        (f(meta::c<plan::order[Ks]>,
+             meta::t<std::tuple_element_t<plan::order[Ks], types>>),
+            ...);
+    }
+
+    /// @brief Invokes `f(i, t)` for every child in `Xs...`, following the
+    /// order of `execution_plan<Xs...>`. `i` is the compile-time index of the
+    /// child and `t` is its type wrapper.
+    template <typename... Xs, typename F>
+    void enumerate_by_plan(F&& f)
+    {
+        enumerate_by_plan_impl<Xs...>(
+            std::index_sequence_for<Xs...>{}, FWD(f));
+    }
+
+    /// @brief Executes the computation of the `Index`-th child inline or
+    /// schedules it, depending on `execution_plan<Xs...>`.
     template <typename... Xs, typename Index, typename Scheduler, typename F>
-    void schedule_if_last(Index, Scheduler& scheduler, F&& f)
+    void schedule_by_plan(Index, Scheduler& scheduler, F&& f)
+    {
+        constexpr bool is_inline =
+            execution_plan<Xs...>::runs_inline(Index{});
+
+        schedule_if<is_inline>(scheduler, FWD(f));
+    }
+
+    template <typename Plan, typename Run, std::size_t... Ks>
+    void run_scheduled_impl(
+        std::index_sequence<Ks...>, std::size_t j, Run& run)
+    {
+        ((j == Ks ? run(meta::c<Plan::order[Ks]>) : void()), ...);
+    }
+
+    template <typename Plan, typename Run, std::size_t... Ks>
+    void run_inline_impl(std::index_sequence<Ks...>, Run& run)
+    {
+        (run(meta::c<Plan::order[Plan::scheduled_count + Ks]>), ...);
+    }
+
+    /// @brief Executes every child in `Xs...` following
+    /// `execution_plan<Xs...>`, by invoking `run(i)` with the compile-time
+    /// index `i` of the child.
+    /// @details If the scheduler supports `bulk(n, f)`, all the scheduled
+    /// children are submitted at once and dispatched through a single copy
+    /// of `run`. Otherwise, each of them is submitted separately.
+    template <typename... Xs, typename Scheduler, typename Run>
+    void execute_by_plan(Scheduler& scheduler, Run&& run)
     {
-        constexpr bool is_last = Index{} == sizeof...(Xs) - 1;
-        schedule_if<is_last>(scheduler, FWD(f));
+        using plan = execution_plan<Xs...>;
+        using traits = orizzonte::scheduler::traits<Scheduler>;
+
+        if constexpr(traits::supports_bulk && plan::scheduled_count > 1)
+        {
+            if(orizzonte::scheduler::should_spawn(scheduler))
+            {
+                scheduler.bulk(plan::scheduled_count,
+                    [run](std::size_t j) mutable {
+                        run_scheduled_impl<plan>(
+                            std::make_index_sequence<plan::scheduled_count>{},
+                            j, run);
+                    });
+
+                run_inline_impl<plan>(
+                    std::make_index_sequence<plan::count -
+                                             plan::scheduled_count>{},
+                    run);
+
+                return;
+            }
+        }
+
+        enumerate_by_plan<Xs...>([&](auto i, auto) {
+            schedule_by_plan<Xs...>(
+                i, scheduler, [run, i]() mutable { run(i); });
+        });
+    }
+
+    /// @brief Nesting bound of nodes that do not provide `inline_depth()`.
+    inline constexpr std::size_t unbounded_depth = std::size_t(-1) / 2;
+
+    template <typename T>
+    using inline_depth_impl = decltype(T::inline_depth());
+
+    /// @brief Upper bound on the number of continuations executing `T` can
+    /// nest on the stack without going through the trampoline. Nodes that do
+    /// not provide an `inline_depth()` static member function are assumed to
+    /// be unbounded.
+    template <typename T>
+    constexpr std::size_t inline_depth_of() noexcept
+    {
+        if constexpr(std::experimental::is_detected_v<inline_depth_impl, T>)
+        {
+            return std::min(T::inline_depth(), unbounded_depth);
+        }
+        else
+        {
+            return unbounded_depth;
+        }
+    }
+
+    template <typename T>
+    using synchronous_impl = decltype(T::synchronous());
+
+    /// @brief Returns `true` if executing `T` invokes its continuations on
+    /// threads that its scheduler controls, i.e. no computation of `T`
+    /// completes asynchronously from an external event source. Nodes that do
+    /// not provide a `synchronous()` static member function are assumed to
+    /// be asynchronous.
+    template <typename T>
+    constexpr bool synchronous_of() noexcept
+    {
+        if constexpr(std::experimental::is_detected_v<synchronous_impl, T>)
+        {
+            return T::synchronous();
+        }
+        else
+        {
+            return false;
+        }
     }
 
     template <typename Tuple>
@@ -73,4 +330,7 @@ namespace orizzonte::node
 {
     template <typename T>
     inline constexpr detail::in_t<utility::void_to_nothing_t<T>> in{};
+
+    template <typename T>
+    inline constexpr detail::out_t<utility::void_to_nothing_t<T>> out{};
 }
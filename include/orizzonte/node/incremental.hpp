@@ -0,0 +1,168 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/nothing.hpp"
+#include "./helper.hpp"
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::node::detail
+{
+    /// @brief Default key of an `incremental` node: a copy of its input.
+    /// Nodes without input have no key.
+    struct input_key
+    {
+        constexpr utility::nothing operator()() const noexcept
+        {
+            return {};
+        }
+
+        template <typename T>
+        constexpr const T& operator()(const T& x) const noexcept
+        {
+            return x;
+        }
+    };
+}
+
+namespace orizzonte::node
+{
+    /// @brief Caches the output of `F` along with a key of the input it was
+    /// computed from. When executed again with an input whose key compares
+    /// equal to the cached one, the cached output is passed on and `F` is
+    /// skipped entirely. Completes with a `const` reference to the output.
+    /// @details The key is a copy of the input by default. `Key` can instead
+    /// compute a version from the input, or from external state for nodes
+    /// without input, e.g. a leaf reading a data source that bumps a counter
+    /// when it changes. Nodes without input and without `Key` are always
+    /// executed. Wrapping the stages of a graph that is executed repeatedly
+    /// makes changes propagate only through the stages whose inputs changed.
+    template <typename F, typename Key = detail::input_key>
+    class incremental : F
+    {
+    public:
+        using in_type = typename F::in_type;
+        using out_type = typename F::out_type;
+
+    private:
+        using key_type = std::decay_t<
+            utility::result_of_ignoring_nothing_t<Key&, const in_type&>>;
+
+        static constexpr bool keyed = !utility::is_nothing_v<key_type>;
+
+        Key _key;
+        std::optional<key_type> _last_key;
+        std::optional<out_type> _last_output;
+
+        template <typename Incremental>
+        constexpr void copy_cache(Incremental&& rhs)
+        {
+            if(rhs._last_key)
+            {
+                _last_key.emplace(*FWD(rhs)._last_key);
+            }
+
+            if(rhs._last_output)
+            {
+                _last_output.emplace(*FWD(rhs)._last_output);
+            }
+        }
+
+    public:
+        constexpr incremental(F&& f) : F{std::move(f)}
+        {
+        }
+
+        constexpr incremental(Key&& key, F&& f)
+            : F{std::move(f)}, _key{std::move(key)}
+        {
+        }
+
+        // Only engaged caches are copied: copying the storage of empty
+        // `std::optional`s makes GCC report uninitialized reads.
+        constexpr incremental(const incremental& rhs)
+            : F{static_cast<const F&>(rhs)}, _key{rhs._key}
+        {
+            copy_cache(rhs);
+        }
+
+        constexpr incremental(incremental&& rhs)
+            : F{static_cast<F&&>(rhs)}, _key{std::move(rhs._key)}
+        {
+            copy_cache(std::move(rhs));
+        }
+
+        /// @brief Forces the next execution to execute `F`.
+        void invalidate() noexcept
+        {
+            _last_key.reset();
+            _last_output.reset();
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&& cleanup) &
+        {
+            if constexpr(keyed)
+            {
+                key_type k = utility::call_ignoring_nothing(
+                    _key, std::as_const(input));
+
+                if(_last_output && *_last_key == k)
+                {
+                    // The cleanups of `F` are accounted for by the caller.
+                    for(std::size_t i = 0; i < F::cleanup_count(); ++i)
+                    {
+                        cleanup();
+                    }
+
+                    then(std::as_const(*_last_output));
+                    return;
+                }
+
+                _last_key.emplace(std::move(k));
+            }
+
+            _last_output.reset();
+
+            static_cast<F&>(*this).execute(scheduler, FWD(input),
+                [this, then](auto&& out) {
+                    _last_output.emplace(FWD(out));
+                    then(std::as_const(*_last_output));
+                },
+                cleanup);
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return detail::cost_of<F>();
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return detail::inline_depth_of<F>() + 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return detail::synchronous_of<F>();
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return F::cleanup_count();
+        }
+    };
+
+    template <typename F>
+    incremental(F)->incremental<F>;
+
+    template <typename Key, typename F>
+    incremental(Key, F)->incremental<F, Key>;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#if defined(__linux__)
+
+#include "../scheduler/reactor.hpp"
+#include "./async_leaf.hpp"
+#include "./helper.hpp"
+#include <cstddef>
+#include <netinet/in.h>
+#include <sys/types.h>
+
+// Leaves performing I/O through a `scheduler::reactor`. They suspend on the
+// reactor instead of blocking a worker, and report errors as `-errno`.
+
+namespace orizzonte::node::io
+{
+    /// @brief Leaf reading up to `n` bytes from `fd` into `buffer`. Outputs
+    /// the number of bytes read (`0` on end-of-file).
+    inline auto read(
+        scheduler::reactor& r, int fd, void* buffer, std::size_t n)
+    {
+        return async_leaf{out<ssize_t>, [&r, fd, buffer, n](auto done) {
+            r.read(fd, buffer, n, std::move(done));
+        }};
+    }
+
+    /// @brief Leaf writing the `n` bytes of `buffer` to `fd`. Outputs `n`.
+    inline auto write(
+        scheduler::reactor& r, int fd, const void* buffer, std::size_t n)
+    {
+        return async_leaf{out<ssize_t>, [&r, fd, buffer, n](auto done) {
+            r.write(fd, buffer, n, std::move(done));
+        }};
+    }
+
+    /// @brief Leaf accepting a connection on `listen_fd`. Outputs the
+    /// non-blocking file descriptor of the connection.
+    inline auto accept(scheduler::reactor& r, int listen_fd)
+    {
+        return async_leaf{out<int>, [&r, listen_fd](auto done) {
+            r.accept(listen_fd, std::move(done));
+        }};
+    }
+
+    /// @brief Leaf connecting a new TCP socket to `address`. Outputs the
+    /// non-blocking file descriptor of the socket.
+    inline auto connect(scheduler::reactor& r, const sockaddr_in& address)
+    {
+        return async_leaf{out<int>, [&r, address](auto done) {
+            r.connect(address, std::move(done));
+        }};
+    }
+
+    /// @brief Leaf reading up to `n` bytes into `buffer` from the file
+    /// descriptor it receives as input.
+    inline auto read_from(scheduler::reactor& r, void* buffer, std::size_t n)
+    {
+        return async_leaf{
+            in<int>, out<ssize_t>, [&r, buffer, n](int fd, auto done) {
+                r.read(fd, buffer, n, std::move(done));
+            }};
+    }
+
+    /// @brief Leaf writing the `n` bytes of `buffer` to the file descriptor
+    /// it receives as input.
+    inline auto write_to(
+        scheduler::reactor& r, const void* buffer, std::size_t n)
+    {
+        return async_leaf{
+            in<int>, out<ssize_t>, [&r, buffer, n](int fd, auto done) {
+                r.write(fd, buffer, n, std::move(done));
+            }};
+    }
+}
+
+#endif
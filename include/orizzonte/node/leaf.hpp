@@ -6,13 +6,14 @@
 
 #include "../utility/noop.hpp"
 #include "../utility/nothing.hpp"
+#include "./cost.hpp"
 #include "./helper.hpp"
 #include "./seq.hpp"
 #include <type_traits>
 
 namespace orizzonte::node
 {
-    template <typename In, typename F>
+    template <typename In, typename F, std::size_t Cost = normal>
     struct leaf : F
     {
     public:
@@ -27,6 +28,15 @@ namespace orizzonte::node
         {
         }
 
+        constexpr leaf(detail::cost_tag<Cost>, F&& f) : leaf{std::move(f)}
+        {
+        }
+
+        constexpr leaf(detail::in_t<In>, detail::cost_tag<Cost>, F&& f)
+            : leaf{std::move(f)}
+        {
+        }
+
         template <typename Scheduler, typename Input, typename Then,
             typename Cleanup>
         void execute(Scheduler&, Input&& input, Then&& then = utility::noop_v,
@@ -39,6 +49,21 @@ namespace orizzonte::node
             FWD(then)(utility::call_ignoring_nothing(*this, FWD(input)));
         }
 
+        static constexpr std::size_t cost() noexcept
+        {
+            return Cost;
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return true;
+        }
+
         static constexpr std::size_t cleanup_count() noexcept
         {
             return 0;
@@ -55,4 +80,14 @@ namespace orizzonte::node
     // TODO: callable_traits
     template <typename F>
     leaf(F)->leaf<detail::first_arg_t<decltype(&F::operator())>, F>;
+
+    template <typename In, typename F>
+    leaf(detail::in_t<In>, F)->leaf<In, F>;
+
+    template <std::size_t Cost, typename F>
+    leaf(detail::cost_tag<Cost>, F)
+        ->leaf<detail::first_arg_t<decltype(&F::operator())>, F, Cost>;
+
+    template <typename In, std::size_t Cost, typename F>
+    leaf(detail::in_t<In>, detail::cost_tag<Cost>, F)->leaf<In, F, Cost>;
 }
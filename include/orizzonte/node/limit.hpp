@@ -0,0 +1,126 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/aligned_storage.hpp"
+#include "../utility/async_semaphore.hpp"
+#include "../utility/movable_atomic.hpp"
+#include "./helper.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace orizzonte::node
+{
+    /// @brief Executes `F` while holding a permit of a
+    /// `utility::async_semaphore`, capping the number of instances of `F`
+    /// running at the same time across every execution sharing the
+    /// semaphore.
+    /// @details An execution that cannot get a permit stores its input and
+    /// is queued in the semaphore, without occupying a worker. It is resumed
+    /// through its scheduler when a permit is handed over to it. The permit
+    /// is held until the result and all the cleanups of `F` were delivered.
+    template <typename F>
+    class limit : F
+    {
+    public:
+        using in_type = typename F::in_type;
+        using out_type = typename F::out_type;
+
+    private:
+        utility::async_semaphore* _semaphore;
+
+        // Input of an execution that had to wait for a permit.
+        utility::aligned_storage_for<in_type> _input;
+        bool _stored{false};
+
+        utility::movable_atomic<int> _left{0};
+
+        // The permit is released before the signal is forwarded, as the
+        // graph, and the semaphore, can be destroyed afterwards.
+        void signal()
+        {
+            if(_left.fetch_sub(1) == 1)
+            {
+                if(_stored)
+                {
+                    _input.destroy();
+                }
+
+                _semaphore->release();
+            }
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void run(Scheduler& scheduler, Input&& input, const Then& then,
+            const Cleanup& cleanup, bool stored)
+        {
+            _stored = stored;
+            _left.store(F::cleanup_count() + 1);
+
+            static_cast<F&>(*this).execute(scheduler, FWD(input),
+                [this, then](auto&& out) {
+                    signal();
+                    then(FWD(out));
+                },
+                [this, cleanup] {
+                    signal();
+                    cleanup();
+                });
+        }
+
+    public:
+        constexpr limit(utility::async_semaphore& semaphore, F&& f)
+            : F{std::move(f)}, _semaphore{&semaphore}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&& cleanup) &
+        {
+            const bool acquired = _semaphore->acquire([&] {
+                _input.construct(FWD(input));
+
+                return [this, &scheduler, then, cleanup] {
+                    detail::schedule_if<false>(
+                        scheduler, [this, &scheduler, then, cleanup] {
+                            run(scheduler, std::move(*_input), then, cleanup,
+                                true);
+                        });
+                };
+            });
+
+            if(acquired)
+            {
+                run(scheduler, FWD(input), then, cleanup, false);
+            }
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return detail::cost_of<F>();
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return detail::inline_depth_of<F>() + 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return false;
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return F::cleanup_count();
+        }
+    };
+
+    template <typename F>
+    limit(utility::async_semaphore&, F)->limit<F>;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./helper.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace orizzonte::node
+{
+    /// @brief Memoizes the pure node `F`, usually a `leaf`, in `Cache`,
+    /// which maps its inputs to its outputs and must be safe to use
+    /// concurrently (see `utility::concurrent_cache`). The cache is declared
+    /// outside of the graph, and can be shared by several `memo` nodes.
+    /// @details On a hit, the cached value is passed to the continuation
+    /// immediately, on the current thread. On a miss, `F` is executed and
+    /// its result is inserted in the cache before being passed on.
+    template <typename Cache, typename F>
+    class memo : F
+    {
+    public:
+        using in_type = typename Cache::key_type;
+        using out_type = typename Cache::value_type;
+
+    private:
+        Cache* _cache;
+
+    public:
+        constexpr memo(Cache& cache, F&& f) : F{std::move(f)}, _cache{&cache}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&& cleanup) &
+        {
+            if(auto hit = _cache->find(std::as_const(input)); hit)
+            {
+                // The cleanups of `F` are accounted for by the caller.
+                for(std::size_t i = 0; i < F::cleanup_count(); ++i)
+                {
+                    cleanup();
+                }
+
+                then(std::move(*hit));
+                return;
+            }
+
+            static_cast<F&>(*this).execute(scheduler, std::as_const(input),
+                [this, key = in_type(input), then](auto&& out) {
+                    _cache->insert(key, out);
+                    then(FWD(out));
+                },
+                cleanup);
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return detail::cost_of<F>();
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return detail::inline_depth_of<F>();
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return detail::synchronous_of<F>();
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return F::cleanup_count();
+        }
+    };
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/aligned_storage.hpp"
+#include "../utility/movable_atomic.hpp"
+#include "./helper.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace orizzonte::node
+{
+    /// @brief Executes `F` on `Target` instead of the scheduler the node is
+    /// executed on, e.g. to keep blocking leaves off a compute pool. Every
+    /// computation submitted by `F` goes to `Target` as well.
+    /// @details The input is stored and `F` is started by a computation
+    /// submitted to `Target`. Once the result and all the cleanups of `F`
+    /// were delivered, the result is handed back to the continuation by a
+    /// computation submitted to the original scheduler: a round trip costs
+    /// one submission in each direction. `Target` must outlive the node.
+    template <typename Target, typename F>
+    class on : F
+    {
+    public:
+        using in_type = typename F::in_type;
+        using out_type = typename F::out_type;
+
+    private:
+        Target* _target;
+        utility::aligned_storage_for<in_type> _input;
+        utility::aligned_storage_for<out_type> _output;
+        utility::movable_atomic<int> _left{0};
+
+        template <typename Scheduler, typename Then>
+        void signal(Scheduler& scheduler, const Then& then)
+        {
+            if(_left.fetch_sub(1) != 1)
+            {
+                return;
+            }
+
+            _input.destroy();
+
+            scheduler([this, then] {
+                // The node can be executed again from `then`.
+                out_type r{std::move(*_output)};
+                _output.destroy();
+                then(std::move(r));
+            });
+        }
+
+    public:
+        constexpr on(Target& target, F&& f)
+            : F{std::move(f)}, _target{&target}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(
+            Scheduler& scheduler, Input&& input, Then&& then, Cleanup&&) &
+        {
+            _input.construct(FWD(input));
+            _left.store(F::cleanup_count() + 1);
+
+            (*_target)([this, &scheduler, then] {
+                static_cast<F&>(*this).execute(*_target, std::move(*_input),
+                    [this, &scheduler, then](auto&& out) {
+                        _output.construct(FWD(out));
+                        signal(scheduler, then);
+                    },
+                    [this, &scheduler, then] { signal(scheduler, then); });
+            });
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return detail::cost_of<F>();
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return detail::inline_depth_of<F>() + 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return false;
+        }
+
+        /// @brief The cleanups of `F` are awaited before transferring the
+        /// result back, and are not forwarded.
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return 0;
+        }
+    };
+
+    template <typename Target, typename F>
+    on(Target&, F)->on<Target, F>;
+}
@@ -0,0 +1,393 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/aligned_storage.hpp"
+#include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/mpmc_queue.hpp"
+#include "../utility/nothing.hpp"
+#include "../utility/spsc_queue.hpp"
+#include "./helper.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::node::detail
+{
+    /// @brief Stage of a `pipeline`, applying `F` to every item. At most one
+    /// item at a time goes through a serial stage, while a parallel stage
+    /// processes up to the capacity of the pipeline concurrently.
+    template <bool Parallel, typename F>
+    struct stage : F
+    {
+        using function_type = F;
+        static constexpr bool parallel = Parallel;
+
+        constexpr stage(F&& f) : F{std::move(f)}
+        {
+        }
+    };
+
+    /// @brief Connection between two stages of a `pipeline`. Uses a
+    /// single-producer single-consumer queue when both stages are serial.
+    template <typename T, bool Spsc>
+    struct pipeline_link
+    {
+        using queue_type = std::conditional_t<Spsc, utility::spsc_queue<T>,
+            utility::mpmc_queue<T>>;
+
+        ORIZZONTE_CACHE_ALIGNED queue_type _queue;
+
+        // Number of items that can be popped from `_queue`. Only increased
+        // after the corresponding push completed.
+        ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _ready{0};
+
+        // Capacity left. Producers reserve a slot before computing an item,
+        // so that a full link stops them before any work is done.
+        ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _free;
+
+        explicit pipeline_link(std::size_t capacity)
+            : _queue{capacity}, _free{capacity}
+        {
+        }
+
+        // The reservations guarantee room for the pushed item and an item to
+        // pop. A multi-producer queue can however still have its cells in
+        // use by concurrent operations for a short while.
+
+        void push(T&& x)
+        {
+            while(!_queue.try_push(std::move(x)))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        T pop()
+        {
+            while(true)
+            {
+                if(auto x = _queue.try_pop(); x)
+                {
+                    return std::move(*x);
+                }
+
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    /// @brief Decrements `x` unless it is zero. Returns `true` on success.
+    inline bool try_decrement(std::atomic<std::size_t>& x) noexcept
+    {
+        std::size_t n = x.load();
+        while(n != 0)
+        {
+            if(x.compare_exchange_weak(n, n - 1))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// @brief Evaluates to a `std::tuple` of the types of the items flowing
+    /// into every stage in `Ss...`, starting from `T`.
+    template <typename T, typename... Ss>
+    struct pipeline_values : meta::type<std::tuple<>>
+    {
+    };
+
+    template <typename T, typename S, typename... Ss>
+    struct pipeline_values<T, S, Ss...>
+    {
+        using next = utility::result_of_ignoring_nothing_t<
+            typename S::function_type&, T&&>;
+
+        using type = decltype(std::tuple_cat(std::declval<std::tuple<T>>(),
+            std::declval<typename pipeline_values<next, Ss...>::type>()));
+    };
+}
+
+namespace orizzonte::node
+{
+    /// @brief Returns a `pipeline` stage that processes one item at a time,
+    /// in the order it receives them.
+    template <typename F>
+    constexpr auto serial(F f)
+    {
+        return detail::stage<false, F>{std::move(f)};
+    }
+
+    /// @brief Returns a `pipeline` stage that processes items concurrently.
+    template <typename F>
+    constexpr auto parallel(F f)
+    {
+        return detail::stage<true, F>{std::move(f)};
+    }
+
+    /// @brief Streams every element of its input range through the stages
+    /// `Ss...`, so that different stages work on different items at the same
+    /// time. The results of the last stage are discarded.
+    /// @details Stages are connected by links holding at most `capacity`
+    /// items. A stage only starts working on an item after reserving room for
+    /// its result in the next link: a slow stage stops upstream stages,
+    /// including the one reading the input, instead of growing memory.
+    /// Items flowing only through serial stages preserve the input order.
+    template <typename Range, typename... Ss>
+    class pipeline : detail::children_of<Ss...>
+    {
+        static_assert(sizeof...(Ss) > 0, "a pipeline needs stages");
+
+    public:
+        using in_type = Range;
+        using out_type = utility::nothing;
+
+    private:
+        using children = detail::children_of<Ss...>;
+
+        using element_type =
+            std::decay_t<decltype(*std::begin(std::declval<Range&>()))>;
+
+        using values =
+            typename detail::pipeline_values<element_type, Ss...>::type;
+
+        // Step `0` reads the input, step `J > 0` executes the `J - 1`-th
+        // stage. Step `J` pops from link `J - 1` and pushes to link `J`.
+        static constexpr std::size_t steps = sizeof...(Ss) + 1;
+
+        static constexpr std::array<bool, steps> parallel_steps{
+            false, Ss::parallel...};
+
+        // Link `I` has a single producer and a single consumer if both steps
+        // `I` and `I + 1` are serial.
+        template <std::size_t... Is>
+        static auto links_type(std::index_sequence<Is...>)
+            -> std::tuple<detail::pipeline_link<std::tuple_element_t<Is, values>,
+                !parallel_steps[Is] && !parallel_steps[Is + 1]>...>;
+
+        using links = decltype(links_type(std::index_sequence_for<Ss...>{}));
+
+        struct ORIZZONTE_CACHE_ALIGNED counter
+        {
+            std::atomic<std::size_t> _value{0};
+        };
+
+        struct shared_state
+        {
+            Range _input;
+            decltype(std::begin(std::declval<Range&>())) _next;
+            links _links;
+
+            // Workers currently executing each step.
+            std::array<counter, steps> _active;
+
+            // Live workers, items in flight, and one reference held until
+            // the input is exhausted. The pipeline completes when it reaches
+            // zero.
+            ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _live{1};
+            ORIZZONTE_CACHE_ALIGNED std::atomic<bool> _exhausted{false};
+
+            template <typename Input, std::size_t... Is>
+            shared_state(Input&& input, std::size_t capacity,
+                std::index_sequence<Is...>)
+                : _input{FWD(input)}, _next{std::begin(_input)},
+                  _links{(void(Is), capacity)...}
+            {
+            }
+        };
+
+        std::size_t _capacity;
+        utility::aligned_storage_for<shared_state> _state;
+
+        template <std::size_t J>
+        auto& link() noexcept
+        {
+            return std::get<J>(_state->_links);
+        }
+
+        template <std::size_t J>
+        std::size_t limit() const noexcept
+        {
+            return parallel_steps[J] ? _capacity : 1;
+        }
+
+        template <std::size_t J>
+        bool runnable() noexcept
+        {
+            bool result;
+            if constexpr(J == 0)
+            {
+                result = !_state->_exhausted.load();
+            }
+            else
+            {
+                result = link<J - 1>()._ready.load() != 0;
+            }
+
+            if constexpr(J + 1 < steps)
+            {
+                result = result && link<J>()._free.load() != 0;
+            }
+
+            return result;
+        }
+
+        template <typename Then>
+        void release(Then& then)
+        {
+            if(_state->_live.fetch_sub(1) == 1)
+            {
+                _state.destroy();
+                then(utility::nothing_v);
+            }
+        }
+
+        /// @brief Starts a worker for step `J`, unless it has no work or
+        /// enough workers are already active.
+        template <std::size_t J, typename Scheduler, typename Then>
+        void try_run(Scheduler& scheduler, const Then& then)
+        {
+            auto& active = _state->_active[J]._value;
+            std::size_t n = active.load();
+
+            while(n < limit<J>() && runnable<J>())
+            {
+                if(active.compare_exchange_weak(n, n + 1))
+                {
+                    _state->_live.fetch_add(1);
+                    detail::schedule_if<false>(
+                        scheduler, [this, &scheduler, then = then]() mutable {
+                            work<J>(scheduler, then);
+                        });
+
+                    return;
+                }
+            }
+        }
+
+        /// @brief Processes items of step `J` until its input is empty or its
+        /// output link is full.
+        template <std::size_t J, typename Scheduler, typename Then>
+        void work(Scheduler& scheduler, Then& then)
+        {
+            auto& s = *_state;
+
+            while(true)
+            {
+                if constexpr(J + 1 < steps)
+                {
+                    if(!detail::try_decrement(link<J>()._free))
+                    {
+                        break;
+                    }
+                }
+
+                if constexpr(J == 0)
+                {
+                    if(s._next == std::end(s._input))
+                    {
+                        ++link<0>()._free;
+                        s._exhausted.store(true);
+                        s._live.fetch_sub(1);
+                        break;
+                    }
+
+                    element_type x{std::move(*s._next)};
+                    ++s._next;
+
+                    s._live.fetch_add(1);
+                    link<0>().push(std::move(x));
+                    ++link<0>()._ready;
+                    try_run<1>(scheduler, then);
+                }
+                else
+                {
+                    auto& in = link<J - 1>();
+                    if(!detail::try_decrement(in._ready))
+                    {
+                        if constexpr(J + 1 < steps)
+                        {
+                            ++link<J>()._free;
+                        }
+
+                        break;
+                    }
+
+                    auto x = in.pop();
+                    ++in._free;
+                    try_run<J - 1>(scheduler, then);
+
+                    auto& f = this->template child<J - 1>();
+                    auto y = utility::call_ignoring_nothing(f, std::move(x));
+
+                    if constexpr(J + 1 < steps)
+                    {
+                        link<J>().push(std::move(y));
+                        ++link<J>()._ready;
+                        try_run<J + 1>(scheduler, then);
+                    }
+                    else
+                    {
+                        // Cannot complete the pipeline, as this worker holds
+                        // a reference.
+                        s._live.fetch_sub(1);
+                    }
+                }
+            }
+
+            // Work that appeared after the last check but before the counter
+            // was decremented would not start any worker otherwise.
+            s._active[J]._value.fetch_sub(1);
+            if(runnable<J>())
+            {
+                try_run<J>(scheduler, then);
+            }
+
+            release(then);
+        }
+
+    public:
+        constexpr pipeline(
+            detail::in_t<Range>, std::size_t capacity, Ss&&... ss)
+            : children{std::move(ss)...}, _capacity{std::max(capacity,
+                                              std::size_t(1))}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&&) &
+        {
+            _state.construct(
+                FWD(input), _capacity, std::index_sequence_for<Ss...>{});
+
+            // The reference held for the input is released by the worker
+            // that exhausts it.
+            try_run<0>(scheduler, then);
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return true;
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return 0;
+        }
+    };
+
+    template <typename Range, typename... Ss>
+    pipeline(detail::in_t<Range>, std::size_t, Ss...)->pipeline<Range, Ss...>;
+}
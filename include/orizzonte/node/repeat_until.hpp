@@ -0,0 +1,150 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../scheduler/traits.hpp"
+#include "../utility/aligned_storage.hpp"
+#include "../utility/maybe_atomic.hpp"
+#include "../utility/trampoline.hpp"
+#include "./helper.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::node
+{
+    /// @brief Executes `F` repeatedly, feeding its output back as its input,
+    /// until `Predicate` holds for an output, which is then the result. `F`
+    /// is executed at least once, and must accept its own output type.
+    /// @details An iteration ends after the result of `F` and all of its
+    /// cleanups were delivered, so that no computation of the previous
+    /// iteration is still running when the next one starts. Values are
+    /// stored in the node itself, alternating between two slots, and
+    /// iterations that complete inline go through the trampoline to bound
+    /// the stack depth. The cleanups of `F` are absorbed.
+    template <typename F, typename Predicate>
+    class repeat_until : F
+    {
+    public:
+        using in_type = typename F::in_type;
+        using out_type = typename F::out_type;
+
+    private:
+        static constexpr int weight = std::min(detail::inline_depth_of<F>(),
+            std::size_t(utility::trampoline_depth));
+
+        Predicate _predicate;
+
+        // Slot `_input` holds the input of the current iteration, or `-1`
+        // during the first one, which reads the input of the node.
+        utility::aligned_storage_for<out_type> _values[2];
+        int _input{-1};
+
+        // Signals left before the current iteration ends. Only engaged
+        // during an execution.
+        utility::aligned_storage_for<utility::maybe_atomic<int>> _left;
+
+        template <typename Scheduler>
+        static constexpr bool atomic() noexcept
+        {
+            return !orizzonte::scheduler::traits<Scheduler>::
+                       is_single_threaded ||
+                   !synchronous();
+        }
+
+        int output() const noexcept
+        {
+            return _input == 0 ? 1 : 0;
+        }
+
+        template <typename Scheduler, typename Input, typename Then>
+        void iterate(Scheduler& scheduler, Input&& input, const Then& then)
+        {
+            constexpr int signals = F::cleanup_count() + 1;
+            _left->template store<atomic<Scheduler>()>(signals);
+
+            static_cast<F&>(*this).execute(scheduler, FWD(input),
+                [this, &scheduler, then](auto&& out) {
+                    _values[output()].construct(FWD(out));
+                    signal(scheduler, then);
+                },
+                [this, &scheduler, then] { signal(scheduler, then); });
+        }
+
+        template <typename Scheduler, typename Then>
+        void signal(Scheduler& scheduler, const Then& then)
+        {
+            if(_left->template fetch_sub<atomic<Scheduler>()>(1) != 1)
+            {
+                return;
+            }
+
+            if(_input != -1)
+            {
+                _values[_input].destroy();
+            }
+
+            _input = output();
+            auto& value = *_values[_input];
+
+            if(_predicate(std::as_const(value)))
+            {
+                // The node can be executed again from `then`.
+                out_type result{std::move(value)};
+                _values[_input].destroy();
+                _input = -1;
+                _left.destroy();
+
+                then(std::move(result));
+                return;
+            }
+
+            utility::trampolined<weight>(
+                [this, &scheduler](const Then& t) {
+                    iterate(scheduler, std::move(*_values[_input]), t);
+                },
+                then);
+        }
+
+    public:
+        constexpr repeat_until(F&& f, Predicate&& predicate)
+            : F{std::move(f)}, _predicate{std::move(predicate)}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(
+            Scheduler& scheduler, Input&& input, Then&& then, Cleanup&&) &
+        {
+            _left.construct();
+            iterate(scheduler, FWD(input), then);
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return detail::cost_of<F>();
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return detail::inline_depth_of<F>() + 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return detail::synchronous_of<F>();
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return 0;
+        }
+    };
+
+    template <typename F, typename Predicate>
+    repeat_until(F, Predicate)->repeat_until<F, Predicate>;
+}
@@ -5,13 +5,24 @@
 #pragma once
 
 #include "../utility/noop.hpp"
+#include "../utility/trampoline.hpp"
 #include "./helper.hpp"
+#include <algorithm>
 
 namespace orizzonte::node
 {
     template <typename A, typename B>
     class seq : A, B
     {
+    private:
+        static constexpr std::size_t unchecked_depth =
+            detail::inline_depth_of<A>() + detail::inline_depth_of<B>();
+
+        // Small enough subgraphs are statically known not to need the
+        // trampoline, and execute without touching its per-thread state.
+        static constexpr bool trampolines =
+            unchecked_depth >= std::size_t(utility::trampoline_depth);
+
     public:
         using in_type = typename A::in_type;
         using out_type = typename B::out_type;
@@ -35,14 +46,66 @@ namespace orizzonte::node
             // as they might both contain a node that has non-deterministic
             // execution.
 
+            // If `A` completes inline, `B` is executed from inside `A`'s
+            // continuation. The trampoline prevents long chains of inline
+            // stages from growing the stack once per stage. Its depth is
+            // increased by the nesting `A` might have accumulated inline.
+
+            constexpr int weight = std::min(detail::inline_depth_of<A>(),
+                std::size_t(utility::trampoline_depth));
+
             static_cast<A&>(*this).execute(scheduler, FWD(input),
                 [this, &scheduler, then, cleanup](auto&& out) {
-                    static_cast<B&>(*this).execute(
-                        scheduler, FWD(out), then, cleanup);
+                    auto k = [this, &scheduler](
+                                 auto&& x, auto&& t, auto&& c) {
+                        static_cast<B&>(*this).execute(
+                            scheduler, FWD(x), FWD(t), FWD(c));
+                    };
+
+                    if constexpr(trampolines)
+                    {
+                        // GCC reports the captured copy of an empty cleanup
+                        // as uninitialized when passing it by reference.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+                        utility::trampolined<weight>(
+                            k, FWD(out), then, cleanup);
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+                    }
+                    else
+                    {
+                        k(FWD(out), then, cleanup);
+                    }
                 },
                 cleanup);
         }
 
+        static constexpr std::size_t cost() noexcept
+        {
+            return detail::cost_of<A>() + detail::cost_of<B>();
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            if constexpr(trampolines)
+            {
+                return detail::inline_depth_of<B>() + 1;
+            }
+            else
+            {
+                return unchecked_depth;
+            }
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return detail::synchronous_of<A>() && detail::synchronous_of<B>();
+        }
+
         static constexpr std::size_t cleanup_count() noexcept
         {
             return A::cleanup_count() + B::cleanup_count();
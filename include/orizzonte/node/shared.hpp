@@ -0,0 +1,212 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/aligned_storage.hpp"
+#include "../utility/task.hpp"
+#include "./helper.hpp"
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace orizzonte::node
+{
+    template <typename F>
+    class shared_ref;
+
+    /// @brief Subgraph `F` whose result is computed once per execution and
+    /// delivered by `const` reference to several consumers, allowing
+    /// diamond-shaped graphs. Declared outside of the graph, which refers to
+    /// it through the nodes returned by `ref()`.
+    /// @details The first `ref()` node to execute runs `F` with its own
+    /// input. The others wait for the result, and are resumed through the
+    /// scheduler as soon as it is ready. The result lives in the `shared`
+    /// object until the next execution starts, or until it is destroyed.
+    /// Every `ref()` node must be executed exactly once per execution.
+    template <typename F>
+    class shared : F
+    {
+        friend class shared_ref<F>;
+
+    public:
+        using in_type = typename F::in_type;
+        using out_type = typename F::out_type;
+
+    private:
+        enum class status
+        {
+            idle,
+            running,
+            ready
+        };
+
+        std::mutex _mutex;
+        status _status{status::idle};
+        std::vector<utility::task> _waiters;
+        utility::aligned_storage_for<out_type> _result;
+        std::size_t _consumers{0};
+        std::size_t _arrived{0};
+
+        const out_type& result() noexcept
+        {
+            return *_result;
+        }
+
+        void reset()
+        {
+            if(_status == status::ready)
+            {
+                _result.destroy();
+            }
+
+            _status = status::idle;
+            _arrived = 0;
+        }
+
+        // Consumers that do not run `F` still account for its cleanups.
+        template <typename Cleanup>
+        static void skip(Cleanup& cleanup)
+        {
+            for(std::size_t i = 0; i < F::cleanup_count(); ++i)
+            {
+                cleanup();
+            }
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void arrive(
+            Scheduler& scheduler, Input&& input, Then& then, Cleanup& cleanup)
+        {
+            std::unique_lock l{_mutex};
+
+            if(_arrived == _consumers)
+            {
+                reset();
+            }
+
+            ++_arrived;
+
+            if(_status == status::ready)
+            {
+                l.unlock();
+                skip(cleanup);
+                then(result());
+                return;
+            }
+
+            if(_status == status::running)
+            {
+                _waiters.emplace_back([this, then] { then(result()); });
+
+                l.unlock();
+                skip(cleanup);
+                return;
+            }
+
+            _status = status::running;
+            l.unlock();
+
+            static_cast<F&>(*this).execute(scheduler, FWD(input),
+                [this, &scheduler, then](auto&& out) {
+                    std::vector<utility::task> waiters;
+
+                    {
+                        std::lock_guard g{_mutex};
+                        _result.construct(FWD(out));
+                        _status = status::ready;
+                        waiters.swap(_waiters);
+                    }
+
+                    for(auto& w : waiters)
+                    {
+                        detail::schedule_if<false>(scheduler, std::move(w));
+                    }
+
+                    then(result());
+                },
+                cleanup);
+        }
+
+    public:
+        constexpr shared(F&& f) : F{std::move(f)}
+        {
+        }
+
+        shared(const shared&) = delete;
+        shared& operator=(const shared&) = delete;
+
+        ~shared()
+        {
+            if(_status == status::ready)
+            {
+                _result.destroy();
+            }
+        }
+
+        /// @brief Returns a node consuming the result of this subgraph. The
+        /// `shared` object must outlive it.
+        shared_ref<F> ref() noexcept
+        {
+            ++_consumers;
+            return shared_ref<F>{*this};
+        }
+    };
+
+    template <typename F>
+    shared(F)->shared<F>;
+
+    /// @brief Node executing, or waiting for, a `shared` subgraph. Its
+    /// continuation receives a `const` reference to the shared result.
+    /// @details Move-only: every `shared_ref` accounts for one consumer,
+    /// registered by `shared::ref()`.
+    template <typename F>
+    class shared_ref
+    {
+        friend class shared<F>;
+
+    public:
+        using in_type = typename F::in_type;
+        using out_type = typename F::out_type;
+
+    private:
+        shared<F>* _shared;
+
+        explicit shared_ref(shared<F>& s) noexcept : _shared{&s}
+        {
+        }
+
+    public:
+        shared_ref(const shared_ref&) = delete;
+        shared_ref& operator=(const shared_ref&) = delete;
+
+        shared_ref(shared_ref&&) = default;
+        shared_ref& operator=(shared_ref&&) = default;
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&& cleanup) &
+        {
+            _shared->arrive(scheduler, FWD(input), then, cleanup);
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return detail::cost_of<F>();
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return detail::synchronous_of<F>();
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return F::cleanup_count();
+        }
+    };
+}
@@ -0,0 +1,207 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/aligned_storage.hpp"
+#include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/task.hpp"
+#include "./helper.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace orizzonte::node
+{
+    template <typename In, typename Key, typename F>
+    class single_flight_ref;
+
+    /// @brief Deduplicates concurrent invocations of `F` with equal keys,
+    /// computed by `Key` from the input. Declared outside of the graphs,
+    /// which refer to it through the nodes returned by `ref()`.
+    /// @details The first execution of a `ref()` node with a given key
+    /// invokes `F` on its own thread. Executions with the same key arriving
+    /// while it is running register themselves as waiters, without blocking,
+    /// and are resumed through their scheduler with a copy of the result.
+    /// Pending keys are stored in a map split in shards, each with its own
+    /// mutex, selected by the hash of the key.
+    template <typename In, typename Key, typename F>
+    class single_flight : F
+    {
+        friend class single_flight_ref<In, Key, F>;
+
+    public:
+        using in_type = In;
+        using out_type = std::decay_t<std::invoke_result_t<F&, In&&>>;
+        using key_type = std::decay_t<std::invoke_result_t<Key&, const In&>>;
+
+    private:
+        struct waiter
+        {
+            utility::aligned_storage_for<out_type>* _slot;
+            utility::task _resume;
+        };
+
+        struct ORIZZONTE_CACHE_ALIGNED shard
+        {
+            std::mutex _mutex;
+            std::unordered_map<key_type, std::vector<waiter>> _flights;
+        };
+
+        Key _key;
+        std::size_t _shard_count;
+        std::unique_ptr<shard[]> _shards;
+
+        shard& shard_of(const key_type& k) noexcept
+        {
+            return _shards[std::hash<key_type>{}(k) % _shard_count];
+        }
+
+        /// @brief Returns `true` if the caller has to invoke `F` and
+        /// `complete` the flight. Otherwise, the computation returned by
+        /// `make_resume()` will be invoked once the result is stored in
+        /// `slot`.
+        template <typename MakeResume>
+        bool join(const key_type& k,
+            utility::aligned_storage_for<out_type>& slot,
+            MakeResume&& make_resume)
+        {
+            auto& s = shard_of(k);
+            std::lock_guard g{s._mutex};
+
+            auto [it, inserted] = s._flights.try_emplace(k);
+            if(!inserted)
+            {
+                it->second.push_back(
+                    waiter{&slot, utility::task{make_resume()}});
+            }
+
+            return inserted;
+        }
+
+        template <typename Input>
+        out_type invoke(Input&& input)
+        {
+            return static_cast<F&>(*this)(FWD(input));
+        }
+
+        void complete(const key_type& k, const out_type& result)
+        {
+            std::vector<waiter> waiters;
+
+            {
+                auto& s = shard_of(k);
+                std::lock_guard g{s._mutex};
+
+                auto it = s._flights.find(k);
+                waiters = std::move(it->second);
+                s._flights.erase(it);
+            }
+
+            for(auto& w : waiters)
+            {
+                w._slot->construct(result);
+                w._resume();
+            }
+        }
+
+        key_type key_of(const In& input)
+        {
+            return _key(input);
+        }
+
+    public:
+        single_flight(detail::in_t<In>, Key&& key, F&& f,
+            std::size_t shards = std::thread::hardware_concurrency())
+            : F{std::move(f)}, _key{std::move(key)},
+              _shard_count{std::max(shards, std::size_t(1))},
+              _shards{std::make_unique<shard[]>(_shard_count)}
+        {
+        }
+
+        single_flight(const single_flight&) = delete;
+        single_flight& operator=(const single_flight&) = delete;
+
+        /// @brief Returns a node invoking `F` on its input, or waiting for a
+        /// concurrent invocation with the same key. The `single_flight`
+        /// object must outlive it.
+        single_flight_ref<In, Key, F> ref() noexcept
+        {
+            return single_flight_ref<In, Key, F>{*this};
+        }
+    };
+
+    template <typename In, typename Key, typename F>
+    single_flight(detail::in_t<In>, Key, F)->single_flight<In, Key, F>;
+
+    template <typename In, typename Key, typename F>
+    single_flight(detail::in_t<In>, Key, F, std::size_t)
+        ->single_flight<In, Key, F>;
+
+    /// @brief Node executing its input through a `single_flight`.
+    template <typename In, typename Key, typename F>
+    class single_flight_ref
+    {
+        friend class single_flight<In, Key, F>;
+
+    public:
+        using in_type = In;
+        using out_type = typename single_flight<In, Key, F>::out_type;
+
+    private:
+        single_flight<In, Key, F>* _flight;
+        utility::aligned_storage_for<out_type> _result;
+
+        explicit single_flight_ref(single_flight<In, Key, F>& f) noexcept
+            : _flight{&f}
+        {
+        }
+
+    public:
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(
+            Scheduler& scheduler, Input&& input, Then&& then, Cleanup&&) &
+        {
+            auto k = _flight->key_of(std::as_const(input));
+
+            const bool leader = _flight->join(k, _result, [&] {
+                return [this, &scheduler, then] {
+                    detail::schedule_if<false>(scheduler, [this, then] {
+                        // The node can be executed again from `then`.
+                        out_type r{std::move(*_result)};
+                        _result.destroy();
+                        then(std::move(r));
+                    });
+                };
+            });
+
+            if(!leader)
+            {
+                return;
+            }
+
+            out_type r = _flight->invoke(FWD(input));
+            _flight->complete(k, r);
+            then(std::move(r));
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return false;
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return 0;
+        }
+    };
+}
@@ -12,9 +12,9 @@
 
 namespace orizzonte::node
 {
-    template <typename In, typename F>
+    template <typename In, typename F, std::size_t Cost>
     template <typename X>
-    auto leaf<In, F>::then(X&& x)
+    auto leaf<In, F, Cost>::then(X&& x)
     {
         if constexpr(detail::is_executable<X>{})
         {
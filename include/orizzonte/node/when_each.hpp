@@ -0,0 +1,222 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../meta/constant.hpp"
+#include "../scheduler/traits.hpp"
+#include "../utility/aligned_storage.hpp"
+#include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/maybe_atomic.hpp"
+#include "../utility/nothing.hpp"
+#include "./helper.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::node::detail
+{
+    template <bool Concurrent>
+    struct each_policy
+    {
+    };
+}
+
+namespace orizzonte::node
+{
+    /// @brief `when_each` policy under which handler invocations never
+    /// overlap. This is the default.
+    inline constexpr detail::each_policy<false> serialized{};
+
+    /// @brief `when_each` policy under which the handler is invoked directly
+    /// by the completing children, possibly at the same time.
+    inline constexpr detail::each_policy<true> concurrent{};
+
+    /// @brief Executes the children `Fs...` in parallel, like `all`, but
+    /// invokes `Handler` with `(index, value)` as soon as each child
+    /// completes, instead of collecting the results. `index` is a
+    /// `std::integral_constant`, convertible to `std::size_t`. Completes with
+    /// `nothing` once every child was handled.
+    /// @details Under the `serialized` policy, a completing child stores its
+    /// value and takes over the handling of pending results only if no other
+    /// thread is doing so. Children never block waiting for the handler.
+    template <bool Concurrent, typename Handler, typename... Fs>
+    class when_each : detail::children_of<Fs...>
+    {
+    public:
+        using in_type = std::common_type_t<typename Fs::in_type...>;
+        using out_type = utility::nothing;
+
+    private:
+        using children = detail::children_of<Fs...>;
+        using values_type =
+            utility::cache_aligned_tuple<typename Fs::out_type...>;
+
+        static constexpr std::size_t count = sizeof...(Fs);
+
+        struct shared_state
+        {
+            ORIZZONTE_CACHE_ALIGNED in_type _input;
+            ORIZZONTE_CACHE_ALIGNED utility::maybe_atomic<int> _left;
+
+            // Serialized policy: indices of the stored values, plus one, in
+            // completion order.
+            ORIZZONTE_CACHE_ALIGNED std::array<std::atomic<std::size_t>, count>
+                _order;
+            ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _tail{0};
+            ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _pending{0};
+            std::size_t _head{0};
+
+            template <bool Atomic, typename Input>
+            shared_state(std::bool_constant<Atomic>, Input&& input)
+                : _input{FWD(input)}
+            {
+                _left.template store<Atomic>(count);
+                for(auto& x : _order)
+                {
+                    x.store(0, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        ORIZZONTE_CACHE_ALIGNED utility::aligned_storage_for<shared_state>
+            _state;
+        ORIZZONTE_CACHE_ALIGNED values_type _values;
+        Handler _handler;
+
+        template <std::size_t... Is>
+        void handle_stored(std::size_t i, std::index_sequence<Is...>)
+        {
+            ((i == Is ? _handler(meta::c<Is>,
+                            std::move(utility::get<Is>(_values)))
+                      : void()),
+                ...);
+        }
+
+        template <typename Then>
+        void finish(Then& then)
+        {
+            _state.destroy();
+            then(utility::nothing_v);
+        }
+
+        template <std::size_t I, typename Then>
+        void store_and_drain(Then& then)
+        {
+            auto& s = *_state;
+            const auto slot = s._tail.fetch_add(1, std::memory_order_relaxed);
+            s._order[slot].store(I + 1, std::memory_order_release);
+
+            if(s._pending.fetch_add(1, std::memory_order_acq_rel) != 0)
+            {
+                // The thread handling results will pick this one up.
+                return;
+            }
+
+            do
+            {
+                std::size_t i;
+                while((i = s._order[s._head].load(
+                           std::memory_order_acquire)) == 0)
+                {
+                    // A child that completed earlier has not published its
+                    // index yet.
+                    std::this_thread::yield();
+                }
+
+                handle_stored(i - 1, std::index_sequence_for<Fs...>{});
+
+                if(++s._head == count)
+                {
+                    finish(then);
+                    return;
+                }
+            } while(s._pending.fetch_sub(1, std::memory_order_acq_rel) != 1);
+        }
+
+    public:
+        constexpr when_each(Handler&& handler, Fs&&... fs)
+            : children{std::move(fs)...}, _handler{std::move(handler)}
+        {
+        }
+
+        constexpr when_each(detail::each_policy<Concurrent>,
+            Handler&& handler, Fs&&... fs)
+            : when_each{std::move(handler), std::move(fs)...}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&& cleanup) &
+        {
+            // As in `all`: children of a synchronous node executed by a
+            // single-threaded scheduler never complete concurrently, which
+            // also makes both policies equivalent.
+            constexpr bool atomic =
+                !orizzonte::scheduler::traits<Scheduler>::is_single_threaded ||
+                !synchronous();
+
+            _state.construct(std::bool_constant<atomic>{}, FWD(input));
+
+            auto run = [this, &scheduler, then, cleanup](auto i) {
+                auto& f = this->template child<decltype(i){}>();
+
+                f.execute(scheduler, _state->_input,
+                    [this, then](auto&& out) {
+                        if constexpr(Concurrent || !atomic)
+                        {
+                            _handler(decltype(i){}, FWD(out));
+
+                            if(_state->_left.template fetch_sub<atomic>(1) ==
+                                1)
+                            {
+                                finish(then);
+                            }
+                        }
+                        else
+                        {
+                            utility::get<decltype(i){}>(_values) = FWD(out);
+                            store_and_drain<decltype(i){}>(then);
+                        }
+                    },
+                    cleanup);
+            };
+
+            detail::execute_by_plan<Fs...>(scheduler, std::move(run));
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return std::max({detail::cost_of<Fs>()...});
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return std::max({detail::inline_depth_of<Fs>()...}) + 1;
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return (detail::synchronous_of<Fs>() && ...);
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return (Fs::cleanup_count() + ...);
+        }
+    };
+
+    template <typename Handler, typename... Fs>
+    when_each(Handler, Fs...)->when_each<false, Handler, Fs...>;
+
+    template <bool Concurrent, typename Handler, typename... Fs>
+    when_each(detail::each_policy<Concurrent>, Handler, Fs...)
+        ->when_each<Concurrent, Handler, Fs...>;
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../scheduler/traits.hpp"
+#include "./helper.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace orizzonte::node
+{
+    /// @brief Executes `F` on the scheduler returned by `at(level)` of the
+    /// scheduler it is executed on, so that every computation submitted
+    /// underneath it has the given priority level.
+    /// @details Transparent on schedulers that do not support priorities.
+    /// The continuation and the cleanups of `F` are forwarded as they are:
+    /// the rest of the graph keeps submitting at its own level.
+    template <typename F>
+    class with_priority : F
+    {
+    public:
+        using in_type = typename F::in_type;
+        using out_type = typename F::out_type;
+
+    private:
+        std::size_t _level;
+
+    public:
+        constexpr with_priority(std::size_t level, F&& f)
+            : F{std::move(f)}, _level{level}
+        {
+        }
+
+        template <typename Scheduler, typename Input, typename Then,
+            typename Cleanup>
+        void execute(Scheduler& scheduler, Input&& input, Then&& then,
+            Cleanup&& cleanup) &
+        {
+            if constexpr(orizzonte::scheduler::traits<
+                             Scheduler>::supports_priority)
+            {
+                static_cast<F&>(*this).execute(scheduler.at(_level),
+                    FWD(input), FWD(then), FWD(cleanup));
+            }
+            else
+            {
+                static_cast<F&>(*this).execute(
+                    scheduler, FWD(input), FWD(then), FWD(cleanup));
+            }
+        }
+
+        static constexpr std::size_t cost() noexcept
+        {
+            return detail::cost_of<F>();
+        }
+
+        static constexpr std::size_t inline_depth() noexcept
+        {
+            return detail::inline_depth_of<F>();
+        }
+
+        static constexpr bool synchronous() noexcept
+        {
+            return detail::synchronous_of<F>();
+        }
+
+        static constexpr std::size_t cleanup_count() noexcept
+        {
+            return F::cleanup_count();
+        }
+    };
+
+    template <typename F>
+    with_priority(std::size_t, F)->with_priority<F>;
+}
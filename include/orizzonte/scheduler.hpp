@@ -0,0 +1,14 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./scheduler/deadline_pool.hpp"
+#include "./scheduler/event_loop.hpp"
+#include "./scheduler/fair_share_pool.hpp"
+#include "./scheduler/inline_scheduler.hpp"
+#include "./scheduler/priority_pool.hpp"
+#include "./scheduler/reactor.hpp"
+#include "./scheduler/thread_pool.hpp"
+#include "./scheduler/traits.hpp"
@@ -0,0 +1,62 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/fwd.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <type_traits>
+
+namespace orizzonte::scheduler::detail
+{
+    /// @brief Shared by all the tasks of a `bulk` submission. The last task to
+    /// complete deletes it.
+    template <typename F>
+    struct bulk_state
+    {
+        F _f;
+        std::atomic<std::size_t> _left;
+    };
+
+    /// @brief Appends `n > 0` tasks invoking `f(i)` to `queue`, for every `i`
+    /// in `[0, n)`. `f` is stored once and shared between them.
+    template <typename Queue, typename F>
+    void enqueue_bulk(Queue& queue, std::size_t n, F&& f)
+    {
+        auto* state = new bulk_state<std::decay_t<F>>{FWD(f), {n}};
+
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            queue.emplace_back([state, i] {
+                state->_f(i);
+
+                if(state->_left.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete state;
+                }
+            });
+        }
+    }
+
+    /// @brief Wakes up as many workers waiting on `cv` as needed to run `n`
+    /// newly queued computations, given that `idle` workers were idle when
+    /// they were published.
+    inline void notify_bulk(
+        std::condition_variable& cv, std::size_t n, int idle)
+    {
+        // Every idle worker gets a task.
+        if(std::size_t(idle) <= n)
+        {
+            cv.notify_all();
+            return;
+        }
+
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            cv.notify_one();
+        }
+    }
+}
@@ -0,0 +1,337 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/eventcount.hpp"
+#include "../utility/fwd.hpp"
+#include "../utility/task.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace orizzonte::scheduler
+{
+    /// @brief Fixed-size pool of worker threads executing computations
+    /// earliest-deadline-first. Computations are submitted through a `frame`
+    /// carrying the deadline of a graph execution.
+    /// @details Every worker owns a min-heap of computations ordered by
+    /// deadline. Computations submitted by a worker go to its own heap, the
+    /// others are distributed round-robin. Idle workers steal the most
+    /// urgent computation of another heap. If `demote_late` is set, a
+    /// computation dequeued after its deadline is moved to a FIFO queue that
+    /// is only served when no computation can still meet its deadline, so
+    /// that late work does not make more work late under overload.
+    /// Computations are never discarded, as graphs wait for all of them.
+    class deadline_pool
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        /// @brief Scheduler submitting computations to a `deadline_pool`
+        /// with a fixed deadline. Must outlive the graph executions it is
+        /// used for, e.g. as a temporary passed to `sync_execute`.
+        class frame
+        {
+            friend class deadline_pool;
+
+        private:
+            deadline_pool* _pool;
+            clock::time_point _deadline;
+            std::atomic<bool> _missed{false};
+
+            frame(deadline_pool& pool, clock::time_point deadline) noexcept
+                : _pool{&pool}, _deadline{deadline}
+            {
+            }
+
+        public:
+            frame(const frame&) = delete;
+            frame& operator=(const frame&) = delete;
+
+            template <typename F>
+            void operator()(F&& f)
+            {
+                _pool->submit(*this, utility::task{FWD(f)});
+            }
+
+            bool should_spawn() const noexcept
+            {
+                return _pool->should_spawn();
+            }
+
+            std::size_t worker_count() const noexcept
+            {
+                return _pool->worker_count();
+            }
+
+            clock::time_point deadline() const noexcept
+            {
+                return _deadline;
+            }
+
+            bool expired() const noexcept
+            {
+                return clock::now() > _deadline;
+            }
+
+            /// @brief Returns `true` if a computation submitted through this
+            /// frame was started after the deadline.
+            bool missed() const noexcept
+            {
+                return _missed.load(std::memory_order_relaxed);
+            }
+        };
+
+    private:
+        struct entry
+        {
+            clock::time_point _deadline;
+            std::uint64_t _sequence;
+            frame* _frame;
+            utility::task _task;
+        };
+
+        // Orders `std::push_heap` and `std::pop_heap` as a min-heap, ties
+        // being broken by submission order.
+        struct later
+        {
+            bool operator()(const entry& a, const entry& b) const noexcept
+            {
+                return a._deadline != b._deadline
+                           ? a._deadline > b._deadline
+                           : a._sequence > b._sequence;
+            }
+        };
+
+        struct ORIZZONTE_CACHE_ALIGNED queue
+        {
+            std::mutex _mutex;
+            std::vector<entry> _heap;
+            std::deque<entry> _late;
+        };
+
+        struct worker_id
+        {
+            const deadline_pool* _pool;
+            std::size_t _index;
+        };
+
+        static worker_id& current() noexcept
+        {
+            static thread_local worker_id id{nullptr, 0};
+            return id;
+        }
+
+        bool _demote_late;
+        std::unique_ptr<queue[]> _queues;
+        std::size_t _queue_count;
+
+        ORIZZONTE_CACHE_ALIGNED std::atomic<int> _pending{0};
+        ORIZZONTE_CACHE_ALIGNED std::atomic<int> _idle{0};
+        std::atomic<std::uint64_t> _sequence{0};
+        std::atomic<bool> _stopped{false};
+        utility::eventcount _ec;
+
+        std::vector<std::thread> _workers;
+
+        void submit(frame& f, utility::task&& t)
+        {
+            const auto& id = current();
+            const std::size_t i = id._pool == this
+                                      ? id._index
+                                      : std::size_t(_sequence.load(
+                                            std::memory_order_relaxed)) %
+                                            _queue_count;
+
+            {
+                auto& q = _queues[i];
+                std::lock_guard g{q._mutex};
+
+                q._heap.push_back(entry{f._deadline,
+                    _sequence.fetch_add(1, std::memory_order_relaxed), &f,
+                    std::move(t)});
+
+                std::push_heap(q._heap.begin(), q._heap.end(), later{});
+            }
+
+            _pending.fetch_add(1, std::memory_order_seq_cst);
+            _ec.notify_one();
+        }
+
+        /// @brief Dequeues the most urgent computation of `q` that can still
+        /// meet its deadline, demoting the late ones.
+        bool pop_heap(queue& q, entry& out, clock::time_point now)
+        {
+            std::lock_guard g{q._mutex};
+
+            while(!q._heap.empty())
+            {
+                std::pop_heap(q._heap.begin(), q._heap.end(), later{});
+                entry e = std::move(q._heap.back());
+                q._heap.pop_back();
+
+                if(e._deadline < now)
+                {
+                    e._frame->_missed.store(true, std::memory_order_relaxed);
+
+                    if(_demote_late)
+                    {
+                        q._late.push_back(std::move(e));
+                        continue;
+                    }
+                }
+
+                out = std::move(e);
+                return true;
+            }
+
+            return false;
+        }
+
+        bool pop_late(queue& q, entry& out)
+        {
+            std::lock_guard g{q._mutex};
+
+            if(q._late.empty())
+            {
+                return false;
+            }
+
+            out = std::move(q._late.front());
+            q._late.pop_front();
+            return true;
+        }
+
+        bool pop(std::size_t i, entry& out)
+        {
+            const auto now = clock::now();
+
+            for(std::size_t k = 0; k < _queue_count; ++k)
+            {
+                if(pop_heap(_queues[(i + k) % _queue_count], out, now))
+                {
+                    return true;
+                }
+            }
+
+            for(std::size_t k = 0; k < _queue_count; ++k)
+            {
+                if(pop_late(_queues[(i + k) % _queue_count], out))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void worker_loop(std::size_t i)
+        {
+            current() = worker_id{this, i};
+
+            while(true)
+            {
+                entry e;
+                if(pop(i, e))
+                {
+                    _pending.fetch_sub(1, std::memory_order_relaxed);
+                    e._task();
+                    continue;
+                }
+
+                _idle.fetch_add(1, std::memory_order_relaxed);
+                const auto key = _ec.prepare_wait();
+
+                // Stops like `thread_pool`, once no computation is pending.
+                if(_pending.load(std::memory_order_seq_cst) != 0)
+                {
+                    _ec.cancel_wait();
+                }
+                else if(_stopped.load(std::memory_order_seq_cst))
+                {
+                    _ec.cancel_wait();
+                    _idle.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+                else
+                {
+                    _ec.wait(key);
+                }
+
+                _idle.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        deadline_pool(
+            std::size_t worker_count = std::thread::hardware_concurrency(),
+            bool demote_late = true)
+            : _demote_late{demote_late},
+              _queue_count{std::max(worker_count, std::size_t(1))}
+        {
+            _queues = std::make_unique<queue[]>(_queue_count);
+
+            _workers.reserve(_queue_count);
+            for(std::size_t i = 0; i < _queue_count; ++i)
+            {
+                _workers.emplace_back([this, i] { worker_loop(i); });
+            }
+        }
+
+        // Prevent copies.
+        deadline_pool(const deadline_pool&) = delete;
+        deadline_pool& operator=(const deadline_pool&) = delete;
+
+        // Prevent moves.
+        deadline_pool(deadline_pool&&) = delete;
+        deadline_pool& operator=(deadline_pool&&) = delete;
+
+        ~deadline_pool()
+        {
+            _stopped.store(true, std::memory_order_seq_cst);
+            _ec.notify_all();
+
+            for(auto& w : _workers)
+            {
+                w.join();
+            }
+        }
+
+        /// @brief Returns a frame submitting computations due at `deadline`.
+        frame with_deadline(clock::time_point deadline) noexcept
+        {
+            return frame{*this, deadline};
+        }
+
+        /// @brief Returns a frame submitting computations due `timeout`
+        /// from now.
+        template <typename Rep, typename Period>
+        frame with_timeout(std::chrono::duration<Rep, Period> timeout) noexcept
+        {
+            return frame{*this, clock::now() +
+                                    std::chrono::duration_cast<clock::duration>(
+                                        timeout)};
+        }
+
+        bool should_spawn() const noexcept
+        {
+            return _pending.load(std::memory_order_relaxed) <
+                   _idle.load(std::memory_order_relaxed);
+        }
+
+        std::size_t worker_count() const noexcept
+        {
+            return _workers.size();
+        }
+    };
+}
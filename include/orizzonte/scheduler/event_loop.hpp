@@ -0,0 +1,72 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/fwd.hpp"
+#include "../utility/task.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace orizzonte::scheduler
+{
+    /// @brief Single-threaded scheduler that queues computations until
+    /// `run()` is invoked.
+    /// @details Computations can be submitted from any thread, e.g. by
+    /// asynchronous nodes completing elsewhere, but are only executed by the
+    /// thread driving the loop. `wait()` blocks that thread until one is
+    /// submitted.
+    class event_loop
+    {
+    private:
+        std::mutex _mtx;
+        std::condition_variable _cv;
+        std::deque<utility::task> _queue;
+
+    public:
+        static constexpr bool is_single_threaded = true;
+
+        /// @brief Submits `f` for execution by the thread driving the loop.
+        /// @details The loop is notified with the lock held, as the
+        /// submission might allow the loop to be destroyed.
+        template <typename F>
+        void operator()(F&& f)
+        {
+            std::scoped_lock lk{_mtx};
+            _queue.emplace_back(FWD(f));
+            _cv.notify_one();
+        }
+
+        /// @brief Executes queued computations, including the ones they
+        /// submit, until the queue is empty.
+        void run()
+        {
+            while(true)
+            {
+                utility::task t;
+
+                {
+                    std::scoped_lock lk{_mtx};
+                    if(_queue.empty())
+                    {
+                        return;
+                    }
+
+                    t = std::move(_queue.front());
+                    _queue.pop_front();
+                }
+
+                t();
+            }
+        }
+
+        /// @brief Blocks until at least one computation is queued.
+        void wait()
+        {
+            std::unique_lock lk{_mtx};
+            _cv.wait(lk, [this] { return !_queue.empty(); });
+        }
+    };
+}
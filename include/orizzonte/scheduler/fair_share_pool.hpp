@@ -0,0 +1,276 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/fwd.hpp"
+#include "../utility/task.hpp"
+#include "./bulk.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace orizzonte::scheduler
+{
+    /// @brief Fixed-size pool of worker threads shared by tenants, each with
+    /// its own FIFO queue and weight. Workers serve the queues by deficit
+    /// round-robin, so that a backlogged tenant gets a share of the
+    /// dequeued computations proportional to its weight.
+    /// @details Computations are submitted for a tenant through the
+    /// scheduler returned by `tenant(id)`: a graph executed on it submits
+    /// every nested computation, e.g. the children of a large `all`, to the
+    /// same queue. Queues are protected by a single mutex, as in
+    /// `thread_pool`, and dequeuing only adds a bounded scan over the
+    /// tenants. The pool itself submits for tenant `0`.
+    class fair_share_pool
+    {
+    public:
+        /// @brief Scheduler submitting computations to a `fair_share_pool`
+        /// on behalf of a tenant. Owned by the pool.
+        class tenant_view
+        {
+            friend class fair_share_pool;
+
+        private:
+            fair_share_pool* _pool;
+            std::size_t _id;
+
+            tenant_view(fair_share_pool& pool, std::size_t id) noexcept
+                : _pool{&pool}, _id{id}
+            {
+            }
+
+        public:
+            template <typename F>
+            void operator()(F&& f)
+            {
+                _pool->submit(_id, FWD(f));
+            }
+
+            template <typename F>
+            void bulk(std::size_t n, F&& f)
+            {
+                _pool->submit_bulk(_id, n, FWD(f));
+            }
+
+            bool should_spawn() const noexcept
+            {
+                return _pool->should_spawn();
+            }
+
+            std::size_t worker_count() const noexcept
+            {
+                return _pool->worker_count();
+            }
+
+            std::size_t id() const noexcept
+            {
+                return _id;
+            }
+        };
+
+    private:
+        struct queue
+        {
+            std::deque<utility::task> _tasks;
+            std::size_t _weight{1};
+        };
+
+        std::mutex _mtx;
+        std::condition_variable _cv;
+        std::vector<queue> _queues;
+        bool _stopped{false};
+
+        // Deficit round-robin state: the tenant being served, and how many
+        // more computations it can dequeue in this round.
+        std::size_t _current{0};
+        std::size_t _credit;
+
+        ORIZZONTE_CACHE_ALIGNED std::atomic<int> _idle{0};
+        ORIZZONTE_CACHE_ALIGNED std::atomic<int> _queued{0};
+
+        std::vector<tenant_view> _views;
+        std::vector<std::thread> _workers;
+
+        // Must be invoked with the lock held, and at least one non-empty
+        // queue. Empty queues forfeit their remaining credit.
+        std::size_t pick_tenant() noexcept
+        {
+            while(_queues[_current]._tasks.empty() || _credit == 0)
+            {
+                _current = (_current + 1) % _queues.size();
+                _credit = _queues[_current]._weight;
+            }
+
+            --_credit;
+            return _current;
+        }
+
+        void worker_loop()
+        {
+            while(true)
+            {
+                utility::task t;
+
+                {
+                    std::unique_lock lk{_mtx};
+
+                    const auto ready = [this] {
+                        return _stopped ||
+                               _queued.load(std::memory_order_relaxed) != 0;
+                    };
+
+                    _idle.fetch_add(1, std::memory_order_relaxed);
+                    _cv.wait(lk, ready);
+                    _idle.fetch_sub(1, std::memory_order_relaxed);
+
+                    // Stops like `thread_pool`, once every queue is empty.
+                    if(_queued.load(std::memory_order_relaxed) == 0)
+                    {
+                        return;
+                    }
+
+                    auto& q = _queues[pick_tenant()]._tasks;
+                    t = std::move(q.front());
+                    q.pop_front();
+                    _queued.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                t();
+            }
+        }
+
+        template <typename F>
+        void submit(std::size_t id, F&& f)
+        {
+            std::scoped_lock lk{_mtx};
+            _queues[id]._tasks.emplace_back(FWD(f));
+            _queued.fetch_add(1, std::memory_order_relaxed);
+            _cv.notify_one();
+        }
+
+        template <typename F>
+        void submit_bulk(std::size_t id, std::size_t n, F&& f)
+        {
+            if(n == 0)
+            {
+                return;
+            }
+
+            int idle;
+
+            {
+                std::scoped_lock lk{_mtx};
+                detail::enqueue_bulk(_queues[id]._tasks, n, FWD(f));
+                _queued.fetch_add(int(n), std::memory_order_relaxed);
+                idle = _idle.load(std::memory_order_relaxed);
+            }
+
+            detail::notify_bulk(_cv, n, idle);
+        }
+
+    public:
+        /// @brief Creates a pool shared by one tenant per element of
+        /// `weights`. A weight of `0` is treated as `1`.
+        fair_share_pool(std::size_t worker_count,
+            std::initializer_list<std::size_t> weights)
+            : _queues(std::max(weights.size(), std::size_t(1)))
+        {
+            std::size_t i = 0;
+            for(const auto w : weights)
+            {
+                _queues[i++]._weight = w;
+            }
+
+            for(auto& q : _queues)
+            {
+                q._weight = std::max(q._weight, std::size_t(1));
+            }
+
+            _credit = _queues[0]._weight;
+
+            for(std::size_t i = 0; i < _queues.size(); ++i)
+            {
+                _views.push_back(tenant_view{*this, i});
+            }
+
+            if(worker_count == 0)
+            {
+                worker_count = 1;
+            }
+
+            _workers.reserve(worker_count);
+            for(std::size_t i = 0; i < worker_count; ++i)
+            {
+                _workers.emplace_back([this] { worker_loop(); });
+            }
+        }
+
+        // Prevent copies.
+        fair_share_pool(const fair_share_pool&) = delete;
+        fair_share_pool& operator=(const fair_share_pool&) = delete;
+
+        // Prevent moves.
+        fair_share_pool(fair_share_pool&&) = delete;
+        fair_share_pool& operator=(fair_share_pool&&) = delete;
+
+        ~fair_share_pool()
+        {
+            {
+                std::scoped_lock lk{_mtx};
+                _stopped = true;
+            }
+
+            _cv.notify_all();
+            for(auto& w : _workers)
+            {
+                w.join();
+            }
+        }
+
+        /// @brief Returns the scheduler submitting computations on behalf of
+        /// tenant `id`, valid as long as the pool.
+        tenant_view& tenant(std::size_t id) noexcept
+        {
+            assert(id < _views.size());
+            return _views[id];
+        }
+
+        template <typename F>
+        void operator()(F&& f)
+        {
+            submit(0, FWD(f));
+        }
+
+        template <typename F>
+        void bulk(std::size_t n, F&& f)
+        {
+            submit_bulk(0, n, FWD(f));
+        }
+
+        bool should_spawn() const noexcept
+        {
+            return _queued.load(std::memory_order_relaxed) <
+                   _idle.load(std::memory_order_relaxed);
+        }
+
+        std::size_t worker_count() const noexcept
+        {
+            return _workers.size();
+        }
+
+        std::size_t tenant_count() const noexcept
+        {
+            return _views.size();
+        }
+    };
+}
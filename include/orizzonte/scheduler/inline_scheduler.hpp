@@ -0,0 +1,24 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/fwd.hpp"
+#include <utility>
+
+namespace orizzonte::scheduler
+{
+    /// @brief Scheduler that immediately executes every computation on the
+    /// submitting thread.
+    struct inline_scheduler
+    {
+        static constexpr bool is_inline = true;
+
+        template <typename F>
+        void operator()(F&& f) const
+        {
+            FWD(f)();
+        }
+    };
+}
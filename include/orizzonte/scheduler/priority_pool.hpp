@@ -0,0 +1,298 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/fwd.hpp"
+#include "../utility/task.hpp"
+#include "./bulk.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace orizzonte::scheduler
+{
+    /// @brief Fixed-size pool of worker threads sharing one FIFO queue per
+    /// priority level. Level `0` is the most urgent.
+    /// @details Workers always dequeue from the most urgent non-empty level,
+    /// unless a less urgent one was passed over `starvation_limit` times in a
+    /// row while non-empty, in which case it is served once. Computations
+    /// are submitted at a level through the scheduler returned by
+    /// `at(level)`: a graph executed on it submits every nested computation
+    /// at the same level. The pool itself submits at the least urgent level.
+    class priority_pool
+    {
+    public:
+        /// @brief Scheduler submitting computations to a `priority_pool` at
+        /// a fixed level. Owned by the pool.
+        class view
+        {
+            friend class priority_pool;
+
+        private:
+            priority_pool* _pool;
+            std::size_t _level;
+
+            view(priority_pool& pool, std::size_t level) noexcept
+                : _pool{&pool}, _level{level}
+            {
+            }
+
+        public:
+            static constexpr bool supports_priority = true;
+
+            template <typename F>
+            void operator()(F&& f)
+            {
+                _pool->submit(_level, FWD(f));
+            }
+
+            template <typename F>
+            void bulk(std::size_t n, F&& f)
+            {
+                _pool->submit_bulk(_level, n, FWD(f));
+            }
+
+            bool should_spawn() const noexcept
+            {
+                return _pool->should_spawn_at(_level);
+            }
+
+            std::size_t worker_count() const noexcept
+            {
+                return _pool->worker_count();
+            }
+
+            view& at(std::size_t level) const noexcept
+            {
+                return _pool->at(level);
+            }
+
+            std::size_t level() const noexcept
+            {
+                return _level;
+            }
+        };
+
+        static constexpr bool supports_priority = true;
+
+    private:
+        std::mutex _mtx;
+        std::condition_variable _cv;
+        std::vector<std::deque<utility::task>> _queues;
+        std::vector<std::size_t> _skipped;
+        std::size_t _starvation_limit;
+        bool _stopped{false};
+
+        ORIZZONTE_CACHE_ALIGNED std::atomic<int> _idle{0};
+        std::unique_ptr<std::atomic<int>[]> _queued;
+
+        std::vector<view> _views;
+        std::vector<std::thread> _workers;
+
+        // Must be invoked with the lock held, and at least one non-empty
+        // queue.
+        std::size_t pick_level() noexcept
+        {
+            const std::size_t levels = _queues.size();
+
+            std::size_t first = 0;
+            while(_queues[first].empty())
+            {
+                ++first;
+            }
+
+            std::size_t chosen = first;
+            for(std::size_t l = first + 1; l < levels; ++l)
+            {
+                if(!_queues[l].empty() && _skipped[l] >= _starvation_limit)
+                {
+                    chosen = l;
+                    break;
+                }
+            }
+
+            for(std::size_t l = first + 1; l < levels; ++l)
+            {
+                if(l != chosen && !_queues[l].empty())
+                {
+                    ++_skipped[l];
+                }
+            }
+
+            _skipped[chosen] = 0;
+            return chosen;
+        }
+
+        void worker_loop()
+        {
+            while(true)
+            {
+                utility::task t;
+
+                {
+                    std::unique_lock lk{_mtx};
+
+                    const auto ready = [this] {
+                        return _stopped ||
+                               std::any_of(_queues.begin(), _queues.end(),
+                                   [](const auto& q) { return !q.empty(); });
+                    };
+
+                    _idle.fetch_add(1, std::memory_order_relaxed);
+                    _cv.wait(lk, ready);
+                    _idle.fetch_sub(1, std::memory_order_relaxed);
+
+                    // Stops like `thread_pool`, once every queue is empty.
+                    if(std::all_of(_queues.begin(), _queues.end(),
+                           [](const auto& q) { return q.empty(); }))
+                    {
+                        return;
+                    }
+
+                    const std::size_t l = pick_level();
+                    t = std::move(_queues[l].front());
+                    _queues[l].pop_front();
+                    _queued[l].fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                t();
+            }
+        }
+
+        template <typename F>
+        void submit(std::size_t level, F&& f)
+        {
+            std::scoped_lock lk{_mtx};
+            _queues[level].emplace_back(FWD(f));
+            _queued[level].fetch_add(1, std::memory_order_relaxed);
+            _cv.notify_one();
+        }
+
+        template <typename F>
+        void submit_bulk(std::size_t level, std::size_t n, F&& f)
+        {
+            if(n == 0)
+            {
+                return;
+            }
+
+            int idle;
+
+            {
+                std::scoped_lock lk{_mtx};
+                detail::enqueue_bulk(_queues[level], n, FWD(f));
+                _queued[level].fetch_add(int(n), std::memory_order_relaxed);
+                idle = _idle.load(std::memory_order_relaxed);
+            }
+
+            detail::notify_bulk(_cv, n, idle);
+        }
+
+        // Less urgent computations do not delay the ones at `level`.
+        bool should_spawn_at(std::size_t level) const noexcept
+        {
+            int queued = 0;
+            for(std::size_t l = 0; l <= level; ++l)
+            {
+                queued += _queued[l].load(std::memory_order_relaxed);
+            }
+
+            return queued < _idle.load(std::memory_order_relaxed);
+        }
+
+    public:
+        priority_pool(
+            std::size_t worker_count = std::thread::hardware_concurrency(),
+            std::size_t levels = 3, std::size_t starvation_limit = 64)
+            : _queues(std::max(levels, std::size_t(1))),
+              _skipped(_queues.size(), 0),
+              _starvation_limit{std::max(starvation_limit, std::size_t(1))},
+              _queued{std::make_unique<std::atomic<int>[]>(_queues.size())}
+        {
+            for(std::size_t l = 0; l < _queues.size(); ++l)
+            {
+                _queued[l].store(0, std::memory_order_relaxed);
+                _views.push_back(view{*this, l});
+            }
+
+            if(worker_count == 0)
+            {
+                worker_count = 1;
+            }
+
+            _workers.reserve(worker_count);
+            for(std::size_t i = 0; i < worker_count; ++i)
+            {
+                _workers.emplace_back([this] { worker_loop(); });
+            }
+        }
+
+        // Prevent copies.
+        priority_pool(const priority_pool&) = delete;
+        priority_pool& operator=(const priority_pool&) = delete;
+
+        // Prevent moves.
+        priority_pool(priority_pool&&) = delete;
+        priority_pool& operator=(priority_pool&&) = delete;
+
+        ~priority_pool()
+        {
+            {
+                std::scoped_lock lk{_mtx};
+                _stopped = true;
+            }
+
+            _cv.notify_all();
+            for(auto& w : _workers)
+            {
+                w.join();
+            }
+        }
+
+        /// @brief Returns the scheduler submitting computations at `level`,
+        /// valid as long as the pool.
+        view& at(std::size_t level) noexcept
+        {
+            assert(level < _views.size());
+            return _views[level];
+        }
+
+        /// @brief Submits `f` at the least urgent level.
+        template <typename F>
+        void operator()(F&& f)
+        {
+            _views.back()(FWD(f));
+        }
+
+        template <typename F>
+        void bulk(std::size_t n, F&& f)
+        {
+            _views.back().bulk(n, FWD(f));
+        }
+
+        bool should_spawn() const noexcept
+        {
+            return should_spawn_at(_views.size() - 1);
+        }
+
+        std::size_t worker_count() const noexcept
+        {
+            return _workers.size();
+        }
+
+        std::size_t levels() const noexcept
+        {
+            return _views.size();
+        }
+    };
+}
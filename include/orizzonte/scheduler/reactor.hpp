@@ -0,0 +1,375 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#if defined(__linux__)
+
+#include "../utility/fwd.hpp"
+#include "../utility/task.hpp"
+#include "./thread_pool.hpp"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace orizzonte::scheduler
+{
+    /// @brief Readiness condition awaited by `reactor::wait`.
+    enum class interest
+    {
+        readable,
+        writable
+    };
+
+    /// @brief Scheduler that executes computations on a `thread_pool`, and
+    /// integrates with the kernel's readiness notifications (`epoll`) so
+    /// that I/O operations suspend on the reactor instead of blocking a
+    /// worker.
+    /// @details A single I/O thread waits for readiness events. Callbacks
+    /// registered through `wait` are submitted to the workers once their
+    /// file descriptor is ready. File descriptors used with the reactor must
+    /// be non-blocking. Pending waits are discarded on destruction.
+    class reactor
+    {
+    private:
+        struct fd_state
+        {
+            std::vector<utility::task> _on_readable;
+            std::vector<utility::task> _on_writable;
+            bool _registered{false};
+        };
+
+        thread_pool _pool;
+        int _epoll;
+        int _wake;
+
+        std::mutex _mtx;
+        std::vector<fd_state> _fds;
+        std::atomic<bool> _stopped{false};
+
+        std::thread _io_thread;
+
+        // Requires `_mtx` to be locked.
+        void arm(int fd, fd_state& s)
+        {
+            epoll_event ev{};
+            ev.events = EPOLLONESHOT;
+            ev.data.fd = fd;
+
+            if(!s._on_readable.empty())
+            {
+                ev.events |= EPOLLIN | EPOLLRDHUP;
+            }
+
+            if(!s._on_writable.empty())
+            {
+                ev.events |= EPOLLOUT;
+            }
+
+            // Closed file descriptors are removed from the interest list by
+            // the kernel, and might have been reused since.
+            if(!s._registered ||
+                (epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &ev) != 0 &&
+                    errno == ENOENT))
+            {
+                epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &ev);
+                s._registered = true;
+            }
+        }
+
+        void io_loop()
+        {
+            constexpr int max_events = 64;
+            epoll_event events[max_events];
+            std::vector<utility::task> ready;
+
+            while(!_stopped.load(std::memory_order_acquire))
+            {
+                const int n = epoll_wait(_epoll, events, max_events, -1);
+
+                {
+                    std::scoped_lock lk{_mtx};
+                    for(int i = 0; i < n; ++i)
+                    {
+                        const int fd = events[i].data.fd;
+                        const auto e = events[i].events;
+
+                        if(fd == _wake)
+                        {
+                            std::uint64_t value;
+                            (void)::read(_wake, &value, sizeof(value));
+                            continue;
+                        }
+
+                        auto& s = _fds[fd];
+                        const auto take = [&ready](auto& waiters) {
+                            for(auto& t : waiters)
+                            {
+                                ready.emplace_back(std::move(t));
+                            }
+
+                            waiters.clear();
+                        };
+
+                        if(e & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                        {
+                            take(s._on_readable);
+                        }
+
+                        if(e & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+                        {
+                            take(s._on_writable);
+                        }
+
+                        if(!s._on_readable.empty() || !s._on_writable.empty())
+                        {
+                            arm(fd, s);
+                        }
+                    }
+                }
+
+                for(auto& t : ready)
+                {
+                    _pool(std::move(t));
+                }
+
+                ready.clear();
+            }
+        }
+
+        static int error_or(int result) noexcept
+        {
+            return result >= 0 ? result : -errno;
+        }
+
+        static bool would_block() noexcept
+        {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        // Writes `bytes[written, n)`, suspending whenever `fd` is full.
+        template <typename Done>
+        void write_from(int fd, const char* bytes, std::size_t n,
+            std::size_t written, Done&& done)
+        {
+            while(written < n)
+            {
+                // Avoids `SIGPIPE` on sockets.
+                auto r = ::send(fd, bytes + written, n - written, MSG_NOSIGNAL);
+                if(r < 0 && errno == ENOTSOCK)
+                {
+                    r = ::write(fd, bytes + written, n - written);
+                }
+
+                if(r >= 0)
+                {
+                    written += std::size_t(r);
+                    continue;
+                }
+
+                if(!would_block())
+                {
+                    FWD(done)(ssize_t(-errno));
+                    return;
+                }
+
+                wait(fd, interest::writable,
+                    [this, fd, bytes, n, written, d = FWD(done)]() mutable {
+                        write_from(fd, bytes, n, written, std::move(d));
+                    });
+
+                return;
+            }
+
+            FWD(done)(ssize_t(n));
+        }
+
+    public:
+        reactor(std::size_t worker_count = std::thread::hardware_concurrency())
+            : _pool{worker_count}, _epoll{epoll_create1(EPOLL_CLOEXEC)},
+              _wake{eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)}
+        {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = _wake;
+            epoll_ctl(_epoll, EPOLL_CTL_ADD, _wake, &ev);
+
+            _io_thread = std::thread{[this] { io_loop(); }};
+        }
+
+        // Prevent copies.
+        reactor(const reactor&) = delete;
+        reactor& operator=(const reactor&) = delete;
+
+        // Prevent moves.
+        reactor(reactor&&) = delete;
+        reactor& operator=(reactor&&) = delete;
+
+        ~reactor()
+        {
+            _stopped.store(true, std::memory_order_release);
+
+            const std::uint64_t one = 1;
+            (void)::write(_wake, &one, sizeof(one));
+            _io_thread.join();
+
+            // Computations still queued on the pool can call `wait`, which
+            // uses the file descriptors and the members below.
+            _pool.join();
+
+            ::close(_wake);
+            ::close(_epoll);
+        }
+
+        /// @brief Submits `f` for execution on one of the workers.
+        template <typename F>
+        void operator()(F&& f)
+        {
+            _pool(FWD(f));
+        }
+
+        /// @copydoc thread_pool::bulk
+        template <typename F>
+        void bulk(std::size_t n, F&& f)
+        {
+            _pool.bulk(n, FWD(f));
+        }
+
+        /// @copydoc thread_pool::should_spawn
+        bool should_spawn() const noexcept
+        {
+            return _pool.should_spawn();
+        }
+
+        std::size_t worker_count() const noexcept
+        {
+            return _pool.worker_count();
+        }
+
+        /// @brief Submits `f` to the workers once `fd` is ready for `i`, or
+        /// once an error or hang-up is reported for it.
+        template <typename F>
+        void wait(int fd, interest i, F&& f)
+        {
+            std::scoped_lock lk{_mtx};
+
+            if(std::size_t(fd) >= _fds.size())
+            {
+                _fds.resize(fd + 1);
+            }
+
+            auto& s = _fds[fd];
+            (i == interest::readable ? s._on_readable : s._on_writable)
+                .emplace_back(FWD(f));
+
+            arm(fd, s);
+        }
+
+        /// @brief Reads up to `n` bytes from `fd` into `buffer`, then invokes
+        /// `done` with the number of bytes read, or with `-errno`.
+        template <typename Done>
+        void read(int fd, void* buffer, std::size_t n, Done&& done)
+        {
+            const auto r = ::read(fd, buffer, n);
+            if(r < 0 && would_block())
+            {
+                wait(fd, interest::readable,
+                    [this, fd, buffer, n, d = FWD(done)]() mutable {
+                        read(fd, buffer, n, std::move(d));
+                    });
+
+                return;
+            }
+
+            FWD(done)(r >= 0 ? r : -errno);
+        }
+
+        /// @brief Writes the `n` bytes of `buffer` to `fd`, then invokes
+        /// `done` with `n`, or with `-errno`.
+        template <typename Done>
+        void write(int fd, const void* buffer, std::size_t n, Done&& done)
+        {
+            write_from(fd, static_cast<const char*>(buffer), n, 0, FWD(done));
+        }
+
+        /// @brief Accepts a connection on `listen_fd`, then invokes `done`
+        /// with the new non-blocking file descriptor, or with `-errno`.
+        template <typename Done>
+        void accept(int listen_fd, Done&& done)
+        {
+            const int fd = ::accept4(
+                listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+            if(fd < 0 && would_block())
+            {
+                wait(listen_fd, interest::readable,
+                    [this, listen_fd, d = FWD(done)]() mutable {
+                        accept(listen_fd, std::move(d));
+                    });
+
+                return;
+            }
+
+            FWD(done)(error_or(fd));
+        }
+
+        /// @brief Connects a new non-blocking TCP socket to `address`, then
+        /// invokes `done` with its file descriptor, or with `-errno`.
+        template <typename Done>
+        void connect(const sockaddr_in& address, Done&& done)
+        {
+            const int fd =
+                ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if(fd < 0)
+            {
+                FWD(done)(-errno);
+                return;
+            }
+
+            if(::connect(fd, reinterpret_cast<const sockaddr*>(&address),
+                   sizeof(address)) == 0)
+            {
+                FWD(done)(fd);
+                return;
+            }
+
+            if(errno != EINPROGRESS)
+            {
+                const int error = errno;
+                ::close(fd);
+                FWD(done)(-error);
+                return;
+            }
+
+            wait(fd, interest::writable, [fd, d = FWD(done)]() mutable {
+                int error = 0;
+                socklen_t length = sizeof(error);
+                ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+
+                if(error != 0)
+                {
+                    ::close(fd);
+                    d(-error);
+                    return;
+                }
+
+                d(fd);
+            });
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,169 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/cache_aligned_tuple.hpp"
+#include "../utility/fwd.hpp"
+#include "../utility/task.hpp"
+#include "./bulk.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace orizzonte::scheduler
+{
+    /// @brief Fixed-size pool of worker threads sharing a single FIFO queue.
+    /// @details Keeps track of the number of idle workers and of the queued
+    /// computations, so that nodes can avoid spawning computations no worker
+    /// would pick up sooner than the current thread (see `should_spawn`).
+    class thread_pool
+    {
+    private:
+        std::mutex _mtx;
+        std::condition_variable _cv;
+        std::deque<utility::task> _queue;
+        bool _stopped{false};
+
+        ORIZZONTE_CACHE_ALIGNED std::atomic<int> _idle{0};
+        ORIZZONTE_CACHE_ALIGNED std::atomic<int> _queued{0};
+
+        std::vector<std::thread> _workers;
+
+        void worker_loop()
+        {
+            while(true)
+            {
+                utility::task t;
+
+                {
+                    std::unique_lock lk{_mtx};
+
+                    _idle.fetch_add(1, std::memory_order_relaxed);
+                    _cv.wait(lk, [this] { return _stopped || !_queue.empty(); });
+                    _idle.fetch_sub(1, std::memory_order_relaxed);
+
+                    // Queued computations are completed before stopping, as
+                    // they might be required for graphs to finish.
+                    if(_queue.empty())
+                    {
+                        return;
+                    }
+
+                    t = std::move(_queue.front());
+                    _queue.pop_front();
+                    _queued.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                t();
+            }
+        }
+
+    public:
+        thread_pool(
+            std::size_t worker_count = std::thread::hardware_concurrency())
+        {
+            if(worker_count == 0)
+            {
+                worker_count = 1;
+            }
+
+            _workers.reserve(worker_count);
+            for(std::size_t i = 0; i < worker_count; ++i)
+            {
+                _workers.emplace_back([this] { worker_loop(); });
+            }
+        }
+
+        // Prevent copies.
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        // Prevent moves.
+        thread_pool(thread_pool&&) = delete;
+        thread_pool& operator=(thread_pool&&) = delete;
+
+        ~thread_pool()
+        {
+            join();
+        }
+
+        /// @brief Completes every queued computation, including the ones
+        /// they submit, and joins the workers. No computation can be
+        /// submitted afterwards.
+        void join()
+        {
+            {
+                std::scoped_lock lk{_mtx};
+                _stopped = true;
+            }
+
+            _cv.notify_all();
+            for(auto& w : _workers)
+            {
+                if(w.joinable())
+                {
+                    w.join();
+                }
+            }
+        }
+
+        /// @brief Submits `f` for execution on one of the workers.
+        /// @details The workers are notified with the lock held: threads
+        /// that are not workers of the pool, e.g. timers or I/O threads, can
+        /// submit computations that allow the pool to be destroyed, which
+        /// must not happen before this function stops using it.
+        template <typename F>
+        void operator()(F&& f)
+        {
+            std::scoped_lock lk{_mtx};
+            _queue.emplace_back(FWD(f));
+            _queued.fetch_add(1, std::memory_order_relaxed);
+            _cv.notify_one();
+        }
+
+        /// @brief Submits `f(i)` for execution on the workers, for every `i`
+        /// in `[0, n)`. `f` must be safe to invoke concurrently.
+        /// @details The whole batch is published with a single lock
+        /// acquisition, and only as many workers as needed are woken up. `f`
+        /// is stored once and shared between the submitted tasks.
+        template <typename F>
+        void bulk(std::size_t n, F&& f)
+        {
+            if(n == 0)
+            {
+                return;
+            }
+
+            int idle;
+
+            {
+                std::scoped_lock lk{_mtx};
+                detail::enqueue_bulk(_queue, n, FWD(f));
+                _queued.fetch_add(int(n), std::memory_order_relaxed);
+                idle = _idle.load(std::memory_order_relaxed);
+            }
+
+            detail::notify_bulk(_cv, n, idle);
+        }
+
+        /// @brief Returns `true` if there are more idle workers than queued
+        /// computations, i.e. if a newly submitted computation would be
+        /// started immediately.
+        bool should_spawn() const noexcept
+        {
+            return _queued.load(std::memory_order_relaxed) <
+                   _idle.load(std::memory_order_relaxed);
+        }
+
+        std::size_t worker_count() const noexcept
+        {
+            return _workers.size();
+        }
+    };
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../utility/noop.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <experimental/type_traits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::scheduler
+{
+    namespace detail
+    {
+        template <typename T>
+        using should_spawn_impl = decltype(std::declval<T&>().should_spawn());
+
+        template <typename T>
+        using is_inline_impl = std::bool_constant<T::is_inline>;
+
+        template <typename T>
+        using is_single_threaded_impl =
+            std::bool_constant<T::is_single_threaded>;
+
+        template <typename T>
+        using supports_bulk_impl = decltype(std::declval<T&>().bulk(
+            std::declval<std::size_t>(), utility::noop_v));
+
+        template <typename T>
+        using worker_count_impl =
+            decltype(std::declval<const T&>().worker_count());
+
+        template <typename T>
+        using supports_priority_impl =
+            std::bool_constant<T::supports_priority>;
+
+        template <template <typename> class Op, typename T>
+        constexpr bool flag_or_false() noexcept
+        {
+            if constexpr(std::experimental::is_detected_v<Op, T>)
+            {
+                return Op<T>::value;
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    /// @brief Compile-time capabilities of `Scheduler`, used by nodes to
+    /// specialize their synchronization.
+    /// @details Schedulers opt into a capability by exposing a `static
+    /// constexpr bool` member with the same name. `supports_bulk` is instead
+    /// detected from the presence of a `bulk(n, f)` member function.
+    template <typename Scheduler>
+    struct traits
+    {
+        using scheduler_type = std::decay_t<Scheduler>;
+
+        /// @brief Every submitted computation is executed immediately, on
+        /// the submitting thread.
+        static constexpr bool is_inline =
+            detail::flag_or_false<detail::is_inline_impl, scheduler_type>();
+
+        /// @brief Every submitted computation is executed on the same thread.
+        /// Single-threaded schedulers that are not inline must provide a
+        /// `run()` member function that executes queued computations until
+        /// none is left, and a `wait()` member function that blocks until a
+        /// computation is submitted, possibly from another thread.
+        static constexpr bool is_single_threaded =
+            is_inline ||
+            detail::flag_or_false<detail::is_single_threaded_impl,
+                scheduler_type>();
+
+        /// @brief The scheduler provides `bulk(n, f)`.
+        static constexpr bool supports_bulk =
+            std::experimental::is_detected_v<detail::supports_bulk_impl,
+                scheduler_type>;
+
+        /// @brief Computations can be submitted with different priorities,
+        /// through the scheduler returned by an `at(level)` member function,
+        /// which must live as long as the scheduler.
+        static constexpr bool supports_priority =
+            detail::flag_or_false<detail::supports_priority_impl,
+                scheduler_type>();
+    };
+
+    /// @brief Returns `true` if submitting a new computation to `scheduler`
+    /// is expected to get it started sooner than executing it inline.
+    /// @details Invokes `scheduler.should_spawn()` if available. Schedulers
+    /// that cannot report their load always spawn.
+    template <typename Scheduler>
+    bool should_spawn(Scheduler& scheduler)
+    {
+        if constexpr(std::experimental::is_detected_v<detail::should_spawn_impl,
+                         Scheduler>)
+        {
+            return scheduler.should_spawn();
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    /// @brief Returns the number of computations `scheduler` can execute in
+    /// parallel.
+    /// @details Invokes `scheduler.worker_count()` if available.
+    /// Single-threaded schedulers execute one computation at a time, while
+    /// the others are assumed to use one thread per core.
+    template <typename Scheduler>
+    std::size_t concurrency(const Scheduler& scheduler)
+    {
+        if constexpr(traits<Scheduler>::is_single_threaded)
+        {
+            (void)scheduler;
+            return 1;
+        }
+        else if constexpr(std::experimental::is_detected_v<
+                              detail::worker_count_impl, Scheduler>)
+        {
+            return std::max(scheduler.worker_count(), std::size_t(1));
+        }
+        else
+        {
+            (void)scheduler;
+            return std::max(
+                std::size_t(std::thread::hardware_concurrency()),
+                std::size_t(1));
+        }
+    }
+}
@@ -5,10 +5,22 @@
 #pragma once
 
 #include "./utility/aligned_storage.hpp"
+#include "./utility/async_semaphore.hpp"
 #include "./utility/bool_latch.hpp"
 #include "./utility/cache_aligned_tuple.hpp"
+#include "./utility/chunked_file.hpp"
+#include "./utility/concurrent_cache.hpp"
+#include "./utility/eventcount.hpp"
+#include "./utility/execute_batch.hpp"
 #include "./utility/fwd.hpp"
+#include "./utility/mapped_file.hpp"
+#include "./utility/maybe_atomic.hpp"
 #include "./utility/movable_atomic.hpp"
+#include "./utility/mpmc_queue.hpp"
 #include "./utility/noop.hpp"
 #include "./utility/nothing.hpp"
+#include "./utility/soa.hpp"
+#include "./utility/spsc_queue.hpp"
 #include "./utility/sync_execute.hpp"
+#include "./utility/task.hpp"
+#include "./utility/trampoline.hpp"
@@ -0,0 +1,88 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./task.hpp"
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace orizzonte::utility
+{
+    /// @brief Counting semaphore whose waiters are computations instead of
+    /// blocked threads.
+    /// @details A computation that cannot get a permit is queued, and is
+    /// invoked by the `release()` call handing the permit over to it, in
+    /// FIFO order.
+    class async_semaphore
+    {
+    private:
+        std::mutex _mutex;
+        std::size_t _permits;
+        std::deque<task> _waiters;
+
+    public:
+        explicit async_semaphore(std::size_t permits) : _permits{permits}
+        {
+        }
+
+        async_semaphore(const async_semaphore&) = delete;
+        async_semaphore& operator=(const async_semaphore&) = delete;
+
+        /// @brief Takes a permit and returns `true` if one is available.
+        /// Otherwise, queues the computation returned by `make_resume()`,
+        /// which will own a permit when invoked, and returns `false`.
+        /// @details `make_resume` is invoked with the lock held.
+        template <typename MakeResume>
+        bool acquire(MakeResume&& make_resume)
+        {
+            std::lock_guard g{_mutex};
+
+            if(_permits != 0)
+            {
+                --_permits;
+                return true;
+            }
+
+            _waiters.emplace_back(make_resume());
+            return false;
+        }
+
+        /// @brief Returns a permit, or hands it over to the oldest waiter,
+        /// which is invoked on the current thread.
+        void release()
+        {
+            task next;
+
+            {
+                std::lock_guard g{_mutex};
+
+                if(_waiters.empty())
+                {
+                    ++_permits;
+                    return;
+                }
+
+                next = std::move(_waiters.front());
+                _waiters.pop_front();
+            }
+
+            next();
+        }
+
+        std::size_t available()
+        {
+            std::lock_guard g{_mutex};
+            return _permits;
+        }
+
+        std::size_t waiting()
+        {
+            std::lock_guard g{_mutex};
+            return _waiters.size();
+        }
+    };
+}
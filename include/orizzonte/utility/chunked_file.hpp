@@ -0,0 +1,92 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./mapped_file.hpp"
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace orizzonte::utility
+{
+    /// @brief Splits `text` into consecutive chunks of roughly `chunk_size`
+    /// bytes. Every chunk but the last one ends right after a `delimiter`, so
+    /// that records are never split. The chunks reference `text`.
+    inline std::vector<std::string_view> split_chunks(
+        std::string_view text, std::size_t chunk_size, char delimiter = '\n')
+    {
+        chunk_size = chunk_size == 0 ? 1 : chunk_size;
+
+        std::vector<std::string_view> result;
+        result.reserve(text.size() / chunk_size + 1);
+
+        std::size_t begin = 0;
+        while(begin < text.size())
+        {
+            std::size_t end = begin + chunk_size;
+            if(end >= text.size())
+            {
+                end = text.size();
+            }
+            else
+            {
+                const auto p = text.find(delimiter, end - 1);
+                end = p == std::string_view::npos ? text.size() : p + 1;
+            }
+
+            result.emplace_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+
+        return result;
+    }
+
+#if defined(__unix__)
+    /// @brief Contents of a file, split into chunks at record boundaries.
+    /// The chunks reference the contents, which are never copied.
+    class chunked_file
+    {
+    private:
+        mapped_file _file;
+        std::vector<std::string_view> _chunks;
+
+    public:
+        chunked_file() = default;
+
+        chunked_file(mapped_file&& file, std::size_t chunk_size,
+            char delimiter = '\n')
+            : _file{std::move(file)},
+              _chunks{split_chunks(_file.view(), chunk_size, delimiter)}
+        {
+        }
+
+        const mapped_file& file() const noexcept
+        {
+            return _file;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return _chunks.size();
+        }
+
+        std::string_view operator[](std::size_t i) const noexcept
+        {
+            return _chunks[i];
+        }
+
+        auto begin() const noexcept
+        {
+            return _chunks.begin();
+        }
+
+        auto end() const noexcept
+        {
+            return _chunks.end();
+        }
+    };
+#endif
+}
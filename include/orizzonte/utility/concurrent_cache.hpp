@@ -0,0 +1,317 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./cache_aligned_tuple.hpp"
+#include "./fwd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace orizzonte::utility
+{
+    /// @brief `concurrent_cache` policy evicting the least recently used
+    /// entry. Every hit reorders the entries, under an exclusive lock.
+    struct lru_eviction
+    {
+    };
+
+    /// @brief `concurrent_cache` policy approximating LRU with a clock hand
+    /// sweeping over reference bits. Hits only set a bit, under a shared
+    /// lock, so that concurrent readers of a shard do not serialize.
+    struct clock_eviction
+    {
+    };
+
+    /// @brief Default `concurrent_cache` weigher: accounts for the inline
+    /// size of keys and values only.
+    struct sizeof_weigher
+    {
+        template <typename K, typename V>
+        constexpr std::size_t operator()(const K&, const V&) const noexcept
+        {
+            return sizeof(K) + sizeof(V);
+        }
+    };
+
+    namespace detail
+    {
+        template <typename K, typename V, typename Policy>
+        class cache_shard;
+
+        template <typename K, typename V>
+        class cache_shard<K, V, lru_eviction>
+        {
+        private:
+            struct entry
+            {
+                K _key;
+                V _value;
+                std::size_t _weight;
+            };
+
+            std::mutex _mutex;
+            std::list<entry> _entries;
+            std::unordered_map<K, typename std::list<entry>::iterator> _index;
+            std::size_t _used{0};
+
+        public:
+            std::optional<V> find(const K& k)
+            {
+                std::lock_guard g{_mutex};
+
+                auto it = _index.find(k);
+                if(it == _index.end())
+                {
+                    return std::nullopt;
+                }
+
+                _entries.splice(_entries.begin(), _entries, it->second);
+                return it->second->_value;
+            }
+
+            void insert(K&& k, V&& v, std::size_t weight, std::size_t budget)
+            {
+                std::lock_guard g{_mutex};
+
+                if(_index.count(k) != 0)
+                {
+                    return;
+                }
+
+                while(!_entries.empty() && _used + weight > budget)
+                {
+                    auto& victim = _entries.back();
+                    _used -= victim._weight;
+                    _index.erase(victim._key);
+                    _entries.pop_back();
+                }
+
+                _entries.push_front(entry{k, std::move(v), weight});
+                _index.emplace(std::move(k), _entries.begin());
+                _used += weight;
+            }
+
+            std::size_t size()
+            {
+                std::lock_guard g{_mutex};
+                return _entries.size();
+            }
+        };
+
+        template <typename K, typename V>
+        class cache_shard<K, V, clock_eviction>
+        {
+        private:
+            struct entry
+            {
+                K _key;
+                V _value;
+                std::size_t _weight;
+                std::atomic<bool> _referenced;
+
+                entry(K&& k, V&& v, std::size_t weight)
+                    : _key{std::move(k)}, _value{std::move(v)},
+                      _weight{weight}, _referenced{false}
+                {
+                }
+            };
+
+            std::shared_mutex _mutex;
+            std::vector<std::unique_ptr<entry>> _ring;
+            std::unordered_map<K, std::size_t> _index;
+            std::size_t _hand{0};
+            std::size_t _used{0};
+
+            void evict_at(std::size_t i)
+            {
+                _used -= _ring[i]->_weight;
+                _index.erase(_ring[i]->_key);
+
+                // The last entry fills the hole.
+                if(i != _ring.size() - 1)
+                {
+                    _ring[i] = std::move(_ring.back());
+                    _index[_ring[i]->_key] = i;
+                }
+
+                _ring.pop_back();
+            }
+
+        public:
+            std::optional<V> find(const K& k)
+            {
+                std::shared_lock g{_mutex};
+
+                auto it = _index.find(k);
+                if(it == _index.end())
+                {
+                    return std::nullopt;
+                }
+
+                auto& e = *_ring[it->second];
+                e._referenced.store(true, std::memory_order_relaxed);
+                return e._value;
+            }
+
+            void insert(K&& k, V&& v, std::size_t weight, std::size_t budget)
+            {
+                std::unique_lock g{_mutex};
+
+                if(_index.count(k) != 0)
+                {
+                    return;
+                }
+
+                while(!_ring.empty() && _used + weight > budget)
+                {
+                    _hand %= _ring.size();
+
+                    auto& e = *_ring[_hand];
+                    if(e._referenced.exchange(false, std::memory_order_relaxed))
+                    {
+                        ++_hand;
+                        continue;
+                    }
+
+                    evict_at(_hand);
+                }
+
+                _ring.push_back(
+                    std::make_unique<entry>(K{k}, std::move(v), weight));
+                _index.emplace(std::move(k), _ring.size() - 1);
+                _used += weight;
+            }
+
+            std::size_t size()
+            {
+                std::shared_lock g{_mutex};
+                return _ring.size();
+            }
+        };
+    }
+
+    /// @brief Bounded map from `K` to `V`, safe to use concurrently. Entries
+    /// are split in shards by the hash of their key, each with its own lock
+    /// and an equal share of a memory budget. Inserting an entry evicts
+    /// others from its shard, according to `Policy`, until the weights of
+    /// the remaining entries fit in the share.
+    /// @details `Weigher` is invoked with a key and a value to estimate the
+    /// memory they use. Lookups are counted as hits or misses, with relaxed
+    /// atomic counters that do not require the lock of the shard.
+    template <typename K, typename V, typename Policy = lru_eviction,
+        typename Weigher = sizeof_weigher>
+    class concurrent_cache : Weigher
+    {
+    public:
+        using key_type = K;
+        using value_type = V;
+
+    private:
+        struct ORIZZONTE_CACHE_ALIGNED shard
+        {
+            detail::cache_shard<K, V, Policy> _entries;
+            std::atomic<std::uint64_t> _hits{0};
+            std::atomic<std::uint64_t> _misses{0};
+        };
+
+        std::size_t _shard_count;
+        std::size_t _shard_budget;
+        std::unique_ptr<shard[]> _shards;
+
+        shard& shard_of(const K& k) noexcept
+        {
+            return _shards[std::hash<K>{}(k) % _shard_count];
+        }
+
+        template <typename F>
+        std::uint64_t sum(F&& f) const noexcept
+        {
+            std::uint64_t result = 0;
+            for(std::size_t i = 0; i < _shard_count; ++i)
+            {
+                result += f(_shards[i]).load(std::memory_order_relaxed);
+            }
+
+            return result;
+        }
+
+    public:
+        /// @brief Creates a cache whose entries weigh at most `budget` bytes
+        /// in total, split in `shards` shards.
+        explicit concurrent_cache(std::size_t budget,
+            std::size_t shards = std::thread::hardware_concurrency(),
+            Weigher weigher = Weigher{})
+            : Weigher{std::move(weigher)},
+              _shard_count{std::max(shards, std::size_t(1))},
+              _shard_budget{budget / _shard_count},
+              _shards{std::make_unique<shard[]>(_shard_count)}
+        {
+        }
+
+        concurrent_cache(const concurrent_cache&) = delete;
+        concurrent_cache& operator=(const concurrent_cache&) = delete;
+
+        /// @brief Returns a copy of the value associated with `k`, if any.
+        std::optional<V> find(const K& k)
+        {
+            auto& s = shard_of(k);
+            auto result = s._entries.find(k);
+
+            (result ? s._hits : s._misses)
+                .fetch_add(1, std::memory_order_relaxed);
+
+            return result;
+        }
+
+        /// @brief Associates `v` with `k`, unless `k` is already present.
+        /// Entries heavier than the share of a shard are not stored.
+        void insert(K k, V v)
+        {
+            const std::size_t weight =
+                static_cast<const Weigher&>(*this)(std::as_const(k), v);
+
+            if(weight > _shard_budget)
+            {
+                return;
+            }
+
+            shard_of(k)._entries.insert(
+                std::move(k), std::move(v), weight, _shard_budget);
+        }
+
+        std::size_t size() const
+        {
+            std::size_t result = 0;
+            for(std::size_t i = 0; i < _shard_count; ++i)
+            {
+                result += _shards[i]._entries.size();
+            }
+
+            return result;
+        }
+
+        std::uint64_t hits() const noexcept
+        {
+            return sum([](shard& s) -> auto& { return s._hits; });
+        }
+
+        std::uint64_t misses() const noexcept
+        {
+            return sum([](shard& s) -> auto& { return s._misses; });
+        }
+    };
+}
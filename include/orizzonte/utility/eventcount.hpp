@@ -0,0 +1,108 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./cache_aligned_tuple.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace orizzonte::utility
+{
+    /// @brief Parks threads waiting for a condition on lock-free data, e.g.
+    /// a non-empty queue, without lost wakeups. Notifying is a single load
+    /// when nobody waits.
+    /// @details Waiters announce themselves before re-checking the condition:
+    /// ```
+    /// auto key = ec.prepare_wait();
+    /// if(condition()) { ec.cancel_wait(); } else { ec.wait(key); }
+    /// ```
+    /// Notifiers make the condition true before calling `notify_*`. Either
+    /// the waiter observes the condition, or the notifier observes the
+    /// waiter and advances the epoch `wait` blocks on.
+    class eventcount
+    {
+    private:
+        // The upper half of `_state` is the epoch, the lower half counts the
+        // announced waiters.
+        static constexpr std::uint64_t waiter = 1;
+        static constexpr std::uint64_t epoch = std::uint64_t(1) << 32;
+        static constexpr std::uint64_t waiters_mask = epoch - 1;
+
+        ORIZZONTE_CACHE_ALIGNED std::atomic<std::uint64_t> _state{0};
+        std::mutex _mutex;
+        std::condition_variable _cv;
+
+        template <bool All>
+        void notify()
+        {
+            // Orders the caller's update of the condition before the read of
+            // the waiters, pairing with the read-modify-write in
+            // `prepare_wait`.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if((_state.load(std::memory_order_relaxed) & waiters_mask) == 0)
+            {
+                return;
+            }
+
+            _state.fetch_add(epoch, std::memory_order_seq_cst);
+
+            // A waiter that read the old epoch is either blocked on `_cv`, or
+            // will re-read the epoch under the lock.
+            {
+                std::lock_guard l{_mutex};
+            }
+
+            if constexpr(All)
+            {
+                _cv.notify_all();
+            }
+            else
+            {
+                _cv.notify_one();
+            }
+        }
+
+    public:
+        using key = std::uint32_t;
+
+        key prepare_wait() noexcept
+        {
+            return key(
+                _state.fetch_add(waiter, std::memory_order_seq_cst) >> 32);
+        }
+
+        void cancel_wait() noexcept
+        {
+            _state.fetch_sub(waiter, std::memory_order_seq_cst);
+        }
+
+        /// @brief Blocks until a notification happens after the
+        /// `prepare_wait` call that returned `k`. May return spuriously.
+        void wait(key k)
+        {
+            {
+                std::unique_lock l{_mutex};
+                while(key(_state.load(std::memory_order_seq_cst) >> 32) == k)
+                {
+                    _cv.wait(l);
+                }
+            }
+
+            _state.fetch_sub(waiter, std::memory_order_seq_cst);
+        }
+
+        void notify_one()
+        {
+            notify<false>();
+        }
+
+        void notify_all()
+        {
+            notify<true>();
+        }
+    };
+}
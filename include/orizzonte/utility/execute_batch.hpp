@@ -0,0 +1,235 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "../scheduler/traits.hpp"
+#include "./bool_latch.hpp"
+#include "./fwd.hpp"
+#include "./maybe_atomic.hpp"
+#include "./nothing.hpp"
+#include "./soa.hpp"
+#include "./sync_execute.hpp"
+#include "./trampoline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace orizzonte::utility
+{
+    namespace detail
+    {
+        template <typename T>
+        struct is_soa : std::false_type
+        {
+        };
+
+        template <typename... Ts>
+        struct is_soa<soa<Ts...>> : std::true_type
+        {
+        };
+
+        template <typename Outputs, typename T>
+        void store_output(Outputs& outputs, std::size_t i, T&& x)
+        {
+            if constexpr(is_nothing_v<T>)
+            {
+                (void)outputs;
+                (void)i;
+            }
+            else if constexpr(is_soa<Outputs>{})
+            {
+                outputs.store(i, FWD(x));
+            }
+            else
+            {
+                outputs[i] = FWD(x);
+            }
+        }
+
+        /// @brief State shared by the frames of an `execute_batch` call.
+        /// @details If `Driven` is `true`, the completion of the batch is
+        /// submitted to the single-threaded scheduler driven by the caller,
+        /// which sets `_finished`, instead of counting down `_done`.
+        template <typename Scheduler, typename Inputs, typename Outputs,
+            bool Driven>
+        struct batch_context
+        {
+            Scheduler& _scheduler;
+            const Inputs& _inputs;
+            Outputs& _outputs;
+            std::atomic<std::size_t> _frames_left;
+            bool_latch _done;
+            bool _finished{false};
+
+            batch_context(Scheduler& scheduler, const Inputs& inputs,
+                Outputs& outputs, std::size_t frames)
+                : _scheduler{scheduler}, _inputs{inputs}, _outputs{outputs},
+                  _frames_left{frames}
+            {
+            }
+
+            void frame_done()
+            {
+                if(_frames_left.fetch_sub(1) != 1)
+                {
+                    return;
+                }
+
+                if constexpr(Driven)
+                {
+                    _scheduler([this] { _finished = true; });
+                }
+                else
+                {
+                    _done.count_down();
+                }
+            }
+        };
+
+        /// @brief Copy of the graph executing the items of the range
+        /// `[_next, _end)` of a batch, one after the other.
+        /// @details Every item waits for the result and the cleanups of the
+        /// graph, plus the return of `execute`. Items completing inline are
+        /// therefore processed by a plain loop, while the last signal of an
+        /// item completing asynchronously resumes the loop on its thread.
+        template <typename Context, typename Graph, bool Atomic>
+        class batch_frame
+        {
+        private:
+            static constexpr int signals = Graph::cleanup_count() + 2;
+
+            Context& _ctx;
+            Graph _graph;
+            std::size_t _next;
+            std::size_t _end;
+            maybe_atomic<int> _left;
+
+            void signal()
+            {
+                if(_left.template fetch_sub<Atomic>(1) == 1)
+                {
+                    run();
+                }
+            }
+
+        public:
+            batch_frame(Context& ctx, const Graph& graph, std::size_t begin,
+                std::size_t end)
+                : _ctx{ctx}, _graph{graph}, _next{begin}, _end{end}
+            {
+            }
+
+            void run()
+            {
+                while(_next != _end)
+                {
+                    const std::size_t i = _next++;
+                    _left.template store<Atomic>(signals);
+
+                    _graph.execute(_ctx._scheduler, _ctx._inputs[i],
+                        [this, i](auto&& out) {
+                            store_output(_ctx._outputs, i, FWD(out));
+                            signal();
+                        },
+                        [this] { signal(); });
+
+                    if(_left.template fetch_sub<Atomic>(1) != 1)
+                    {
+                        return;
+                    }
+                }
+
+                _ctx.frame_done();
+            }
+        };
+    }
+
+    /// @brief Executes `graph` once for every element of `inputs`, storing
+    /// the result of the `i`-th execution in `outputs[i]`, and blocks until
+    /// the whole batch completed.
+    /// @details The batch is split in contiguous chunks, one per worker of
+    /// the scheduler plus one for the current thread. Each chunk is executed
+    /// by its own copy of `graph`, whose state is reused between items, and
+    /// a single latch is awaited for the whole batch. `outputs` must have at
+    /// least as many elements as `inputs`: if it is a `soa` and the graph
+    /// produces tuples, their fields are scattered into its columns.
+    /// Outputs can be written concurrently, so they cannot be a packed
+    /// `std::vector<bool>`: `soa<bool>` stores one byte per element instead.
+    template <typename Scheduler, typename Graph, typename Inputs,
+        typename Outputs>
+    void execute_batch(Scheduler&& scheduler, const Graph& graph,
+        const Inputs& inputs, Outputs& outputs)
+    {
+        using traits = orizzonte::scheduler::traits<Scheduler>;
+        using scheduler_type = std::remove_reference_t<Scheduler>;
+
+        static_assert(!std::is_same_v<Outputs, std::vector<bool>>,
+            "`std::vector<bool>` outputs cannot be written concurrently");
+
+        constexpr bool synchronous = detail::is_synchronous<Graph>();
+        constexpr bool atomic = !traits::is_single_threaded || !synchronous;
+        constexpr bool driven =
+            traits::is_single_threaded && !traits::is_inline && !synchronous;
+
+        using context =
+            detail::batch_context<scheduler_type, Inputs, Outputs, driven>;
+
+        using frame = detail::batch_frame<context, Graph, atomic>;
+
+        const std::size_t n = std::size(inputs);
+        assert(std::size(outputs) >= n);
+
+        if(n == 0)
+        {
+            return;
+        }
+
+        const std::size_t extra = traits::is_single_threaded ? 0 : 1;
+        const std::size_t frames = std::min(
+            orizzonte::scheduler::concurrency(scheduler) + extra, n);
+
+        [[maybe_unused]] trampoline_scope_for<Graph> scope;
+        context ctx{scheduler, inputs, outputs, frames};
+
+        std::vector<std::unique_ptr<frame>> fs;
+        fs.reserve(frames);
+        for(std::size_t i = 0; i < frames; ++i)
+        {
+            fs.emplace_back(std::make_unique<frame>(
+                ctx, graph, n * i / frames, n * (i + 1) / frames));
+        }
+
+        for(std::size_t i = 1; i < frames; ++i)
+        {
+            scheduler([f = fs[i].get()] { f->run(); });
+        }
+
+        fs[0]->run();
+
+        if constexpr(traits::is_inline && synchronous)
+        {
+            // Every frame completed inline.
+        }
+        else if constexpr(traits::is_single_threaded && synchronous)
+        {
+            scheduler.run();
+        }
+        else if constexpr(driven)
+        {
+            detail::drive_until(
+                scheduler, scope, [&ctx] { return ctx._finished; });
+        }
+        else
+        {
+            scope.drain();
+            ctx._done.wait();
+        }
+    }
+}
@@ -0,0 +1,190 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#if defined(__unix__)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace orizzonte::utility
+{
+    /// @brief Read-only view of the contents of a file. The file is
+    /// memory-mapped when possible. Otherwise, it is read with `pread` in
+    /// large blocks into a page-aligned buffer.
+    /// @details A failure to open or read the file results in an empty view,
+    /// with `error()` returning the corresponding `errno`.
+    class mapped_file
+    {
+    private:
+        static constexpr std::size_t alignment = 4096;
+        static constexpr std::size_t block_size = 8 * 1024 * 1024;
+
+        const char* _data{nullptr};
+        std::size_t _size{0};
+        bool _mapped{false};
+        int _error{0};
+
+        void release() noexcept
+        {
+            if(_mapped)
+            {
+                ::munmap(const_cast<char*>(_data), _size);
+            }
+            else
+            {
+                std::free(const_cast<char*>(_data));
+            }
+
+            _data = nullptr;
+            _size = 0;
+            _mapped = false;
+        }
+
+        bool map(int fd) noexcept
+        {
+            void* p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(p == MAP_FAILED)
+            {
+                return false;
+            }
+
+            ::madvise(p, _size, MADV_SEQUENTIAL);
+            _data = static_cast<const char*>(p);
+            _mapped = true;
+            return true;
+        }
+
+        bool read(int fd) noexcept
+        {
+            // Rounded up, as `aligned_alloc` requires a multiple of the
+            // alignment.
+            const auto capacity = (_size + alignment) / alignment * alignment;
+            auto* buffer =
+                static_cast<char*>(std::aligned_alloc(alignment, capacity));
+
+            if(buffer == nullptr)
+            {
+                _error = ENOMEM;
+                return false;
+            }
+
+            std::size_t offset = 0;
+            while(offset < _size)
+            {
+                const auto n = ::pread(fd, buffer + offset,
+                    std::min(block_size, _size - offset), off_t(offset));
+
+                if(n <= 0)
+                {
+                    _error = n == 0 ? EIO : errno;
+                    std::free(buffer);
+                    return false;
+                }
+
+                offset += std::size_t(n);
+            }
+
+            _data = buffer;
+            return true;
+        }
+
+    public:
+        mapped_file() noexcept = default;
+
+        /// @brief Opens the file at `path`. If `use_mmap` is `false`, the
+        /// file is always read into a buffer.
+        explicit mapped_file(const char* path, bool use_mmap = true) noexcept
+        {
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if(fd < 0)
+            {
+                _error = errno;
+                return;
+            }
+
+            struct stat st;
+            if(::fstat(fd, &st) != 0)
+            {
+                _error = errno;
+            }
+            else if((_size = std::size_t(st.st_size)) != 0 &&
+                    !(use_mmap && map(fd)) && !read(fd))
+            {
+                _size = 0;
+            }
+
+            ::close(fd);
+        }
+
+        mapped_file(mapped_file&& rhs) noexcept
+            : _data{std::exchange(rhs._data, nullptr)},
+              _size{std::exchange(rhs._size, 0)},
+              _mapped{std::exchange(rhs._mapped, false)}, _error{rhs._error}
+        {
+        }
+
+        mapped_file& operator=(mapped_file&& rhs) noexcept
+        {
+            if(this != &rhs)
+            {
+                release();
+                _data = std::exchange(rhs._data, nullptr);
+                _size = std::exchange(rhs._size, 0);
+                _mapped = std::exchange(rhs._mapped, false);
+                _error = rhs._error;
+            }
+
+            return *this;
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        ~mapped_file()
+        {
+            release();
+        }
+
+        const char* data() const noexcept
+        {
+            return _data;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return _size;
+        }
+
+        std::string_view view() const noexcept
+        {
+            return {_data, _size};
+        }
+
+        /// @brief Returns `true` if the contents are memory-mapped, `false`
+        /// if they were read into a buffer.
+        bool mapped() const noexcept
+        {
+            return _mapped;
+        }
+
+        /// @brief Returns the `errno` value of the failure that resulted in
+        /// an empty view, or `0`.
+        int error() const noexcept
+        {
+            return _error;
+        }
+    };
+}
+
+#endif
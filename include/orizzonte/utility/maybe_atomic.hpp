@@ -0,0 +1,64 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include <atomic>
+#include <new>
+
+namespace orizzonte::utility
+{
+    /// @brief Integral value that is accessed either atomically or as a
+    /// plain `T`, depending on a compile-time flag chosen by the user.
+    /// @details Used by nodes to avoid atomic read-modify-write operations
+    /// when all their computations are known to run on a single thread. The
+    /// flag passed to `store` decides which member is active, and must be the
+    /// same for every subsequent operation.
+    template <typename T>
+    class maybe_atomic
+    {
+    private:
+        union
+        {
+            std::atomic<T> _atomic;
+            T _plain;
+        };
+
+    public:
+        maybe_atomic() noexcept : _plain{}
+        {
+        }
+
+        template <bool Atomic>
+        void store(T x) noexcept
+        {
+            if constexpr(Atomic)
+            {
+                // `std::atomic` construction is not atomic.
+                new(&_atomic) std::atomic<T>;
+                _atomic.store(x, std::memory_order_release);
+            }
+            else
+            {
+                _plain = x;
+            }
+        }
+
+        /// @brief Subtracts `x` and returns the previous value.
+        template <bool Atomic>
+        T fetch_sub(T x) noexcept
+        {
+            if constexpr(Atomic)
+            {
+                return _atomic.fetch_sub(x, std::memory_order_acq_rel);
+            }
+            else
+            {
+                const T result = _plain;
+                _plain -= x;
+                return result;
+            }
+        }
+    };
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./cache_aligned_tuple.hpp"
+#include "./fwd.hpp"
+#include "./spsc_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::utility
+{
+    /// @brief Bounded lock-free FIFO queue for any number of producer and
+    /// consumer threads, based on Dmitry Vyukov's design. The capacity is
+    /// rounded up to a power of two, and is at least two.
+    /// @details Every cell carries a sequence number telling whether it is
+    /// ready to be written or read for a given position. Producers and
+    /// consumers only contend on their own index. An operation can fail
+    /// while a concurrent one on the same cell is still in progress, even if
+    /// the queue is not full (or empty) as a whole.
+    template <typename T>
+    class mpmc_queue
+    {
+    private:
+        struct cell
+        {
+            std::atomic<std::size_t> _sequence;
+            std::aligned_storage_t<sizeof(T), alignof(T)> _storage;
+
+            T& value() noexcept
+            {
+                return *std::launder(reinterpret_cast<T*>(&_storage));
+            }
+        };
+
+        const std::size_t _mask;
+        const std::unique_ptr<cell[]> _cells;
+
+        ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _tail{0};
+        ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _head{0};
+
+        static std::ptrdiff_t distance(std::size_t a, std::size_t b) noexcept
+        {
+            return static_cast<std::ptrdiff_t>(a - b);
+        }
+
+    public:
+        explicit mpmc_queue(std::size_t capacity)
+            : _mask{round_up_to_power_of_two(std::max(
+                        capacity, std::size_t(2))) -
+                    1},
+              _cells{new cell[_mask + 1]}
+        {
+            for(std::size_t i = 0; i <= _mask; ++i)
+            {
+                _cells[i]._sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        ~mpmc_queue()
+        {
+            while(try_pop())
+            {
+            }
+        }
+
+        /// @brief Constructs an element from `xs...` at the back of the
+        /// queue. Returns `false`, without touching `xs...`, if the cell at
+        /// the back is still occupied.
+        template <typename... Ts>
+        bool try_emplace(Ts&&... xs)
+        {
+            auto pos = _tail.load(std::memory_order_relaxed);
+            cell* c;
+
+            while(true)
+            {
+                c = &_cells[pos & _mask];
+                const auto seq = c->_sequence.load(std::memory_order_acquire);
+                const auto d = distance(seq, pos);
+
+                if(d == 0)
+                {
+                    if(_tail.compare_exchange_weak(
+                           pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if(d < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = _tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            new(&c->_storage) T(FWD(xs)...);
+            c->_sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(T&& x)
+        {
+            return try_emplace(std::move(x));
+        }
+
+        bool try_push(const T& x)
+        {
+            return try_emplace(x);
+        }
+
+        /// @brief Removes the element at the front of the queue, unless the
+        /// cell at the front was not written yet.
+        std::optional<T> try_pop()
+        {
+            auto pos = _head.load(std::memory_order_relaxed);
+            cell* c;
+
+            while(true)
+            {
+                c = &_cells[pos & _mask];
+                const auto seq = c->_sequence.load(std::memory_order_acquire);
+                const auto d = distance(seq, pos + 1);
+
+                if(d == 0)
+                {
+                    if(_head.compare_exchange_weak(
+                           pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if(d < 0)
+                {
+                    return std::nullopt;
+                }
+                else
+                {
+                    pos = _head.load(std::memory_order_relaxed);
+                }
+            }
+
+            T& x = c->value();
+            std::optional<T> result{std::move(x)};
+            x.~T();
+
+            c->_sequence.store(pos + _mask + 1, std::memory_order_release);
+            return result;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return _mask + 1;
+        }
+    };
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./fwd.hpp"
+#include <cstddef>
+#include <experimental/type_traits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace orizzonte::utility
+{
+    namespace detail
+    {
+        template <typename T>
+        using member_get_impl =
+            decltype(std::declval<T>().template get<std::size_t(0)>());
+
+        /// @brief Returns the `I`-th element of `t`, which is either a
+        /// `std::tuple` or a `cache_aligned_tuple`.
+        template <std::size_t I, typename Tuple>
+        decltype(auto) element(Tuple&& t)
+        {
+            if constexpr(std::experimental::is_detected_v<member_get_impl,
+                             Tuple&&>)
+            {
+                return FWD(t).template get<I>();
+            }
+            else
+            {
+                return std::get<I>(FWD(t));
+            }
+        }
+
+        // `std::vector<bool>` packs its elements, which cannot be written
+        // concurrently.
+        template <typename T>
+        using soa_column = std::vector<
+            std::conditional_t<std::is_same_v<T, bool>, unsigned char, T>>;
+    }
+
+    /// @brief Structure-of-arrays buffer: stores rows of `Ts...` as one
+    /// contiguous column per type, so that consumers reading a single field
+    /// of many rows touch only the memory of that field.
+    /// @details Different rows can be stored concurrently: `bool` fields are
+    /// stored one per byte, in a column of `unsigned char`.
+    template <typename... Ts>
+    class soa
+    {
+    private:
+        std::tuple<detail::soa_column<Ts>...> _columns;
+
+        template <typename Tuple, std::size_t... Is>
+        void store_impl(std::size_t i, Tuple&& row, std::index_sequence<Is...>)
+        {
+            ((std::get<Is>(_columns)[i] = detail::element<Is>(FWD(row))), ...);
+        }
+
+    public:
+        soa() = default;
+
+        explicit soa(std::size_t n)
+        {
+            resize(n);
+        }
+
+        void resize(std::size_t n)
+        {
+            std::apply([n](auto&... cs) { (cs.resize(n), ...); }, _columns);
+        }
+
+        std::size_t size() const noexcept
+        {
+            return std::get<0>(_columns).size();
+        }
+
+        /// @brief Returns the column storing the `I`-th field of every row.
+        template <std::size_t I>
+        auto& column() noexcept
+        {
+            return std::get<I>(_columns);
+        }
+
+        /// @copydoc column
+        template <std::size_t I>
+        const auto& column() const noexcept
+        {
+            return std::get<I>(_columns);
+        }
+
+        /// @brief Scatters the fields of the tuple `row` into the `i`-th
+        /// element of every column.
+        template <typename Tuple>
+        void store(std::size_t i, Tuple&& row)
+        {
+            store_impl(i, FWD(row), std::index_sequence_for<Ts...>{});
+        }
+    };
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./cache_aligned_tuple.hpp"
+#include "./fwd.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace orizzonte::utility
+{
+    /// @brief Returns the smallest power of two greater than or equal to `x`.
+    constexpr std::size_t round_up_to_power_of_two(std::size_t x) noexcept
+    {
+        std::size_t result = 1;
+        while(result < x)
+        {
+            result *= 2;
+        }
+
+        return result;
+    }
+
+    /// @brief Bounded lock-free FIFO queue for one producer thread and one
+    /// consumer thread. The capacity is rounded up to a power of two.
+    /// @details Each side caches the last index it read from the other one,
+    /// so that the shared cache lines are only touched when the queue looks
+    /// full or empty.
+    template <typename T>
+    class spsc_queue
+    {
+    private:
+        using storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+        const std::size_t _mask;
+        const std::unique_ptr<storage[]> _slots;
+
+        // Consumer side.
+        ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _head{0};
+        std::size_t _cached_tail{0};
+
+        // Producer side.
+        ORIZZONTE_CACHE_ALIGNED std::atomic<std::size_t> _tail{0};
+        std::size_t _cached_head{0};
+
+        T& at(std::size_t i) noexcept
+        {
+            return *std::launder(reinterpret_cast<T*>(&_slots[i & _mask]));
+        }
+
+    public:
+        explicit spsc_queue(std::size_t capacity)
+            : _mask{round_up_to_power_of_two(capacity) - 1},
+              _slots{new storage[_mask + 1]}
+        {
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        ~spsc_queue()
+        {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            for(auto i = _head.load(std::memory_order_relaxed); i != tail; ++i)
+            {
+                at(i).~T();
+            }
+        }
+
+        /// @brief Constructs an element from `xs...` at the back of the
+        /// queue. Returns `false`, without touching `xs...`, if it is full.
+        /// Must only be called by the producer.
+        template <typename... Ts>
+        bool try_emplace(Ts&&... xs)
+        {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            if(tail - _cached_head > _mask)
+            {
+                _cached_head = _head.load(std::memory_order_acquire);
+                if(tail - _cached_head > _mask)
+                {
+                    return false;
+                }
+            }
+
+            new(&_slots[tail & _mask]) T(FWD(xs)...);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(T&& x)
+        {
+            return try_emplace(std::move(x));
+        }
+
+        bool try_push(const T& x)
+        {
+            return try_emplace(x);
+        }
+
+        /// @brief Removes the element at the front of the queue, if any.
+        /// Must only be called by the consumer.
+        std::optional<T> try_pop()
+        {
+            const auto head = _head.load(std::memory_order_relaxed);
+            if(head == _cached_tail)
+            {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+                if(head == _cached_tail)
+                {
+                    return std::nullopt;
+                }
+            }
+
+            T& x = at(head);
+            std::optional<T> result{std::move(x)};
+            x.~T();
+
+            _head.store(head + 1, std::memory_order_release);
+            return result;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return _mask + 1;
+        }
+    };
+}
@@ -4,26 +4,169 @@
 
 #pragma once
 
+#include "../scheduler/traits.hpp"
 #include "./bool_latch.hpp"
 #include "./fwd.hpp"
+#include "./noop.hpp"
 #include "./nothing.hpp"
+#include "./trampoline.hpp"
+#include <cassert>
+#include <experimental/type_traits>
 #include <type_traits>
 
 namespace orizzonte::utility
 {
-    /// @brief TODO
+    namespace detail
+    {
+        template <typename T>
+        using synchronous_impl = decltype(T::synchronous());
+
+        template <typename T>
+        constexpr bool is_synchronous() noexcept
+        {
+            if constexpr(std::experimental::is_detected_v<synchronous_impl, T>)
+            {
+                return T::synchronous();
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        // The strategies are separate functions rather than `if constexpr`
+        // branches: generic lambdas in discarded branches make compilation
+        // time explode with long `then` chains.
+
+        template <typename Scheduler, typename Graph, typename Then>
+        void sync_execute_inline(Scheduler& scheduler, Graph& graph, Then& then)
+        {
+            graph.execute(scheduler, nothing_v,
+                [&](auto&&... res) { call_ignoring_nothing(then, FWD(res)...); },
+                noop_v);
+        }
+
+        template <int Count, typename Scheduler, typename Graph, typename Then>
+        void sync_execute_single_threaded(
+            Scheduler& scheduler, Graph& graph, Then& then)
+        {
+            int left = Count;
+
+            graph.execute(scheduler, nothing_v,
+                [&](auto&&... res) {
+                    call_ignoring_nothing(then, FWD(res)...);
+                    --left;
+                },
+                [&] { --left; });
+
+            scheduler.run();
+            assert(left == 0);
+        }
+
+        /// @brief Drives the single-threaded `scheduler` on the current
+        /// thread until `done()` returns `true`, blocking while its queue is
+        /// empty. `done` must only become `true` through a computation
+        /// submitted to `scheduler`, so that it wakes the current thread up.
+        template <typename Scheduler, typename Scope, typename Done>
+        void drive_until(Scheduler& scheduler, Scope& scope, Done&& done)
+        {
+            while(true)
+            {
+                scheduler.run();
+                scope.drain();
+
+                if(done())
+                {
+                    return;
+                }
+
+                scheduler.wait();
+            }
+        }
+
+        template <int Count, typename Scheduler, typename Graph, typename Then,
+            typename Scope>
+        void sync_execute_single_threaded_async(
+            Scheduler& scheduler, Graph& graph, Then& then, Scope& scope)
+        {
+            int left = Count;
+
+            // Signals can be delivered by other threads: they are submitted
+            // to the scheduler, which only executes them on this thread.
+            const auto signal = [&scheduler, &left] {
+                scheduler([&left] { --left; });
+            };
+
+            graph.execute(scheduler, nothing_v,
+                [&](auto&&... res) {
+                    call_ignoring_nothing(then, FWD(res)...);
+                    signal();
+                },
+                signal);
+
+            drive_until(scheduler, scope, [&left] { return left == 0; });
+        }
+
+        template <int Count, typename Scheduler, typename Graph, typename Then,
+            typename Scope>
+        void sync_execute_latch(
+            Scheduler& scheduler, Graph& graph, Then& then, Scope& scope)
+        {
+            utility::int_latch l{Count};
+
+            graph.execute(scheduler, nothing_v,
+                [&](auto&&... res) {
+                    // then(FWD(res)...);
+                    call_ignoring_nothing(then, FWD(res)...);
+                    l.count_down();
+                },
+                [&] { l.count_down(); });
+
+            scope.drain();
+            l.wait();
+        }
+    }
+
+    /// @brief Executes `graph` on `scheduler`, invoking `then` with its
+    /// result, and blocks until every computation of the graph completed.
+    /// @details No synchronization is performed with inline schedulers, as
+    /// the graph is completed when `execute` returns. Single-threaded
+    /// schedulers are driven on the current thread through their `run()`
+    /// member function, using a plain counter instead of a latch. Both only
+    /// apply to synchronous graphs: graphs that can complete from an
+    /// external event source are awaited with a latch, except on
+    /// single-threaded schedulers, which receive the signals of the graph as
+    /// computations and are driven until the last one is executed. Graphs
+    /// that might go through the trampoline are executed in their own
+    /// `trampoline_scope`, so that they can complete even when
+    /// `sync_execute` is invoked from a nested continuation.
     template <typename Scheduler, typename Graph, typename Then>
     void sync_execute(Scheduler&& scheduler, Graph&& graph, Then&& then)
     {
-        constexpr int count = std::decay_t<Graph>::cleanup_count() + 1;
-        utility::scoped_int_latch l{count};
-
-        graph.execute(scheduler, nothing_v,
-            [&](auto&&... res) {
-                // then(FWD(res)...);
-                call_ignoring_nothing(then, FWD(res)...);
-                l.count_down();
-            },
-            [&] { l.count_down(); });
+        using traits = orizzonte::scheduler::traits<Scheduler>;
+        using graph_type = std::decay_t<Graph>;
+        constexpr int count = graph_type::cleanup_count() + 1;
+        constexpr bool synchronous = detail::is_synchronous<graph_type>();
+
+        [[maybe_unused]] trampoline_scope_for<graph_type> scope;
+
+        if constexpr(traits::is_inline && synchronous)
+        {
+            detail::sync_execute_inline(scheduler, graph, then);
+        }
+        else if constexpr(traits::is_single_threaded && synchronous)
+        {
+            detail::sync_execute_single_threaded<count>(
+                scheduler, graph, then);
+        }
+        else if constexpr(traits::is_single_threaded && !traits::is_inline)
+        {
+            detail::sync_execute_single_threaded_async<count>(
+                scheduler, graph, then, scope);
+        }
+        else
+        {
+            detail::sync_execute_latch<count>(scheduler, graph, then, scope);
+        }
     }
 }
@@ -0,0 +1,161 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./fwd.hpp"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Size of the inline buffer of `task`. Callables that do not fit are stored
+// on the heap.
+#ifndef ORIZZONTE_TASK_BUFFER_SIZE
+#define ORIZZONTE_TASK_BUFFER_SIZE 96
+#endif
+
+namespace orizzonte::utility
+{
+    inline constexpr std::size_t task_buffer_size = ORIZZONTE_TASK_BUFFER_SIZE;
+
+    /// @brief Move-only type-erased `void()` callable, used by schedulers to
+    /// store submitted computations.
+    /// @details Callables up to `task_buffer_size` bytes that are nothrow
+    /// move constructible are stored inline, without dynamic allocation.
+    class task
+    {
+    private:
+        struct vtable
+        {
+            void (*_invoke)(void*);
+            void (*_relocate)(void*, void*) noexcept;
+            void (*_destroy)(void*) noexcept;
+        };
+
+        template <typename F>
+        static constexpr bool fits_inline =
+            sizeof(F) <= task_buffer_size &&
+            alignof(F) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<F>;
+
+        template <typename F>
+        static F& as(void* p) noexcept
+        {
+            if constexpr(fits_inline<F>)
+            {
+                return *std::launder(reinterpret_cast<F*>(p));
+            }
+            else
+            {
+                return **std::launder(reinterpret_cast<F**>(p));
+            }
+        }
+
+        template <typename F>
+        static constexpr vtable vtable_for{
+            // _invoke
+            [](void* p) { as<F>(p)(); },
+
+            // _relocate
+            [](void* dst, void* src) noexcept {
+                if constexpr(fits_inline<F>)
+                {
+                    new(dst) F(std::move(as<F>(src)));
+                    as<F>(src).~F();
+                }
+                else
+                {
+                    new(dst) F*(&as<F>(src));
+                }
+            },
+
+            // _destroy
+            [](void* p) noexcept {
+                if constexpr(fits_inline<F>)
+                {
+                    as<F>(p).~F();
+                }
+                else
+                {
+                    delete &as<F>(p);
+                }
+            }};
+
+        alignas(std::max_align_t) unsigned char _buffer[task_buffer_size];
+        const vtable* _vtable{nullptr};
+
+        void reset() noexcept
+        {
+            if(_vtable != nullptr)
+            {
+                _vtable->_destroy(_buffer);
+                _vtable = nullptr;
+            }
+        }
+
+    public:
+        task() noexcept = default;
+
+        template <typename FFwd, typename F = std::decay_t<FFwd>,
+            typename = std::enable_if_t<!std::is_same_v<F, task>>>
+        task(FFwd&& f) : _vtable{&vtable_for<F>}
+        {
+            if constexpr(fits_inline<F>)
+            {
+                new(_buffer) F(FWD(f));
+            }
+            else
+            {
+                new(_buffer) F*(new F(FWD(f)));
+            }
+        }
+
+        task(task&& rhs) noexcept : _vtable{rhs._vtable}
+        {
+            if(_vtable != nullptr)
+            {
+                _vtable->_relocate(_buffer, rhs._buffer);
+                rhs._vtable = nullptr;
+            }
+        }
+
+        task& operator=(task&& rhs) noexcept
+        {
+            if(this != &rhs)
+            {
+                reset();
+                _vtable = rhs._vtable;
+
+                if(_vtable != nullptr)
+                {
+                    _vtable->_relocate(_buffer, rhs._buffer);
+                    rhs._vtable = nullptr;
+                }
+            }
+
+            return *this;
+        }
+
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        ~task()
+        {
+            reset();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return _vtable != nullptr;
+        }
+
+        /// @brief Invokes the stored callable. The behavior is undefined if
+        /// the task is empty.
+        void operator()()
+        {
+            _vtable->_invoke(_buffer);
+        }
+    };
+}
@@ -0,0 +1,364 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#pragma once
+
+#include "./fwd.hpp"
+#include <cstddef>
+#include <experimental/type_traits>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Maximum number of nested inline continuations on a single thread before
+// they start getting deferred to the outermost trampoline frame of the
+// current `trampoline_scope`. Defining this as `0` disables trampolining
+// entirely.
+#ifndef ORIZZONTE_TRAMPOLINE_DEPTH
+#define ORIZZONTE_TRAMPOLINE_DEPTH 32
+#endif
+
+// Size of the per-thread buffer deferred continuations are relocated into.
+// Continuations that do not fit are executed inline instead.
+#ifndef ORIZZONTE_TRAMPOLINE_BUFFER_SIZE
+#define ORIZZONTE_TRAMPOLINE_BUFFER_SIZE 2048
+#endif
+
+namespace orizzonte::utility
+{
+    inline constexpr int trampoline_depth = ORIZZONTE_TRAMPOLINE_DEPTH;
+
+    inline constexpr std::size_t trampoline_buffer_size =
+        ORIZZONTE_TRAMPOLINE_BUFFER_SIZE;
+
+    namespace detail
+    {
+        /// @brief Per-thread state of the trampoline: the current inline
+        /// nesting depth and a LIFO stack of deferred continuations.
+        class trampoline_state
+        {
+        private:
+            static constexpr std::size_t npos = std::size_t(-1);
+
+            struct header
+            {
+                void (*_run)(void*);
+                std::size_t _previous;
+                std::size_t _payload;
+            };
+
+            alignas(std::max_align_t)
+                unsigned char _buffer[trampoline_buffer_size];
+
+            std::size_t _top{0};
+            std::size_t _last{npos};
+            int _depth{0};
+
+            static constexpr std::size_t align_up(
+                std::size_t x, std::size_t alignment) noexcept
+            {
+                return (x + alignment - 1) & ~(alignment - 1);
+            }
+
+            template <typename T>
+            T* at(std::size_t offset) noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(_buffer + offset));
+            }
+
+            template <typename F>
+            static void run_thunk(void* payload)
+            {
+                // The continuation is moved out of the buffer before being
+                // invoked, as it might defer more continuations on top of the
+                // space it used to occupy.
+                F* p = static_cast<F*>(payload);
+                F f{std::move(*p)};
+                p->~F();
+
+                f();
+            }
+
+        public:
+            /// @brief Depth and deferred continuations of an enclosing
+            /// trampoline scope.
+            struct snapshot
+            {
+                std::size_t _last;
+                std::size_t _top;
+                int _depth;
+            };
+
+            static trampoline_state& get() noexcept
+            {
+                static thread_local trampoline_state s;
+                return s;
+            }
+
+            /// @brief Hides the current continuations, which stay in the
+            /// buffer below the ones deferred from now on, and resets the
+            /// depth.
+            snapshot enter() noexcept
+            {
+                const snapshot result{_last, _top, _depth};
+                _last = npos;
+                _depth = 0;
+                return result;
+            }
+
+            /// @brief Restores the state hidden by `enter`. The behavior is
+            /// undefined if continuations were deferred in between and not
+            /// run.
+            void leave(const snapshot& x) noexcept
+            {
+                _last = x._last;
+                _top = x._top;
+                _depth = x._depth;
+            }
+
+            int& depth() noexcept
+            {
+                return _depth;
+            }
+
+            bool empty() const noexcept
+            {
+                return _last == npos;
+            }
+
+            /// @brief Returns `true` if a continuation of type `F` can be
+            /// deferred into the buffer.
+            template <typename F>
+            bool fits() const noexcept
+            {
+                if constexpr(alignof(F) > alignof(std::max_align_t))
+                {
+                    return false;
+                }
+                else
+                {
+                    const auto start = align_up(_top, alignof(header));
+                    const auto payload =
+                        align_up(start + sizeof(header), alignof(F));
+
+                    return payload + sizeof(F) <= trampoline_buffer_size;
+                }
+            }
+
+            /// @brief Constructs a continuation of type `F` on top of the
+            /// buffer. The behavior is undefined if `fits<F>()` is `false`.
+            template <typename F, typename... Args>
+            void push(Args&&... args)
+            {
+                const auto start = align_up(_top, alignof(header));
+                const auto payload =
+                    align_up(start + sizeof(header), alignof(F));
+
+                new(_buffer + payload) F(FWD(args)...);
+                new(_buffer + start) header{&run_thunk<F>, _last, payload};
+
+                _last = start;
+                _top = payload + sizeof(F);
+            }
+
+            /// @brief Pops the most recently deferred continuation and runs
+            /// it. The behavior is undefined if the stack is empty.
+            void pop_and_run()
+            {
+                header* h = at<header>(_last);
+                const auto run = h->_run;
+                void* payload = _buffer + h->_payload;
+
+                _top = _last;
+                _last = h->_previous;
+
+                run(payload);
+            }
+        };
+
+        /// @brief Deferred invocation of `F` with owned copies of its
+        /// arguments.
+        template <typename F, typename... Ts>
+        class trampoline_thunk
+        {
+        private:
+            F _f;
+            std::tuple<Ts...> _args;
+
+        public:
+            template <typename FFwd, typename... TFwds>
+            trampoline_thunk(FFwd&& f, TFwds&&... xs)
+                : _f{FWD(f)}, _args{FWD(xs)...}
+            {
+            }
+
+            void operator()()
+            {
+                std::apply(std::move(_f), std::move(_args));
+            }
+        };
+
+        /// @brief Increments the current thread's inline continuation depth
+        /// for the lifetime of the guard.
+        template <int Weight = 1>
+        class trampoline_depth_guard
+        {
+        private:
+            int& _depth;
+
+        public:
+            trampoline_depth_guard(int& depth) noexcept : _depth{depth}
+            {
+                _depth += Weight;
+            }
+
+            ~trampoline_depth_guard()
+            {
+                _depth -= Weight;
+            }
+        };
+    }
+
+    /// @brief Gives the current thread a fresh trampoline for the lifetime of
+    /// the scope. Must enclose any wait for computations executed through
+    /// `trampolined`, e.g. in `sync_execute`.
+    /// @details Without a scope, continuations deferred by a nested
+    /// execution would be queued to an enclosing `trampolined` frame, which
+    /// cannot run them before the nested wait returns.
+    class trampoline_scope
+    {
+    private:
+        detail::trampoline_state& _state;
+        detail::trampoline_state::snapshot _saved;
+
+    public:
+        trampoline_scope() noexcept
+            : _state{detail::trampoline_state::get()}, _saved{_state.enter()}
+        {
+        }
+
+        trampoline_scope(const trampoline_scope&) = delete;
+        trampoline_scope& operator=(const trampoline_scope&) = delete;
+
+        ~trampoline_scope()
+        {
+            drain();
+            _state.leave(_saved);
+        }
+
+        /// @brief Runs the continuations deferred in this scope. Must be
+        /// invoked before blocking.
+        void drain()
+        {
+            if constexpr(trampoline_depth != 0)
+            {
+                while(!_state.empty())
+                {
+                    detail::trampoline_depth_guard<> g{_state.depth()};
+                    _state.pop_and_run();
+                }
+            }
+        }
+    };
+
+    namespace detail
+    {
+        /// @brief Stand-in for `trampoline_scope` around graphs that never
+        /// go through the trampoline.
+        struct null_trampoline_scope
+        {
+            void drain() noexcept
+            {
+            }
+        };
+
+        template <typename T>
+        using inline_depth_impl = decltype(T::inline_depth());
+
+        /// @brief Returns `true` if executing `Graph` might go through the
+        /// trampoline, i.e. if its inline nesting is not statically known
+        /// to stay below `trampoline_depth`.
+        template <typename Graph>
+        constexpr bool may_trampoline() noexcept
+        {
+            if constexpr(trampoline_depth == 0)
+            {
+                return false;
+            }
+            else if constexpr(std::experimental::is_detected_v<
+                                  inline_depth_impl, Graph>)
+            {
+                return Graph::inline_depth() >=
+                       std::size_t(trampoline_depth);
+            }
+            else
+            {
+                return true;
+            }
+        }
+    }
+
+    /// @brief `trampoline_scope` if executing `Graph` might go through the
+    /// trampoline, and an empty stand-in otherwise, so that small graphs do
+    /// not touch the per-thread state.
+    template <typename Graph>
+    using trampoline_scope_for =
+        std::conditional_t<detail::may_trampoline<Graph>(), trampoline_scope,
+            detail::null_trampoline_scope>;
+
+    /// @brief Invokes `f(xs...)` as an inline continuation, bounding the stack
+    /// depth of long chains of continuations that complete synchronously.
+    /// @details If more than `trampoline_depth` inline continuations are
+    /// already nested on the current thread, `f` and decay-copies of `xs...`
+    /// are instead deferred to the outermost `trampolined` frame of the
+    /// current `trampoline_scope`, which runs them after unwinding. No
+    /// dynamic allocation is performed: deferred continuations live in a
+    /// fixed per-thread buffer, and are executed inline if they do not fit.
+    /// `Weight` is the number of nested continuations the call accounts for,
+    /// including the ones that were executed inline without going through
+    /// the trampoline.
+    template <int Weight = 1, typename F, typename... Ts>
+    void trampolined(F&& f, Ts&&... xs)
+    {
+        if constexpr(trampoline_depth == 0)
+        {
+            FWD(f)(FWD(xs)...);
+        }
+        else
+        {
+            using thunk = detail::trampoline_thunk<std::decay_t<F>,
+                std::decay_t<Ts>...>;
+
+            auto& s = detail::trampoline_state::get();
+
+            if(s.depth() >= trampoline_depth && s.template fits<thunk>())
+            {
+                s.template push<thunk>(FWD(f), FWD(xs)...);
+                return;
+            }
+
+            if(s.depth() != 0)
+            {
+                detail::trampoline_depth_guard<Weight> g{s.depth()};
+                FWD(f)(FWD(xs)...);
+                return;
+            }
+
+            // This is the outermost frame of the current scope: after the
+            // inline continuation returns, act as the loop that runs every
+            // continuation that was deferred in the meantime.
+            {
+                detail::trampoline_depth_guard<Weight> g{s.depth()};
+                FWD(f)(FWD(xs)...);
+            }
+
+            while(!s.empty())
+            {
+                detail::trampoline_depth_guard<> g{s.depth()};
+                s.pop_and_run();
+            }
+        }
+    }
+}
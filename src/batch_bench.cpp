@@ -0,0 +1,87 @@
+#include "../include/orizzonte.hpp"
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+// Runs `f` a few times and prints the throughput for `items` items.
+template <typename TF>
+void bench(const std::string& title, std::size_t items, TF&& f)
+{
+    constexpr int times = 5;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::nanoseconds>(dur)
+                   .count();
+    }
+
+    const double seconds = (acc / times) / 1e9;
+    std::cout << title << " | " << (items / seconds / 1e6) << " M items/s\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::execute_batch;
+using orizzonte::utility::soa;
+using orizzonte::utility::sync_execute;
+
+int work(int x)
+{
+    for(volatile int i = 0; i < 50; ++i)
+    {
+        x = x * 31 + i;
+    }
+
+    return x;
+}
+
+auto graph()
+{
+    return all{leaf{[](int x) { return work(x); }},
+        leaf{[](int x) { return work(x + 1) & 0xff; }}};
+}
+
+void throughput(thread_pool& pool, std::size_t n)
+{
+    std::vector<int> inputs(n);
+    std::iota(inputs.begin(), inputs.end(), 0);
+
+    const std::string size = std::to_string(n);
+
+    bench("loop of sync_execute, n = " + size + "\t", n, [&] {
+        soa<int, int> outputs(n);
+
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            auto item = seq{leaf{[x = inputs[i]] { return x; }}, graph()};
+            sync_execute(pool, item, [&](const auto& r) {
+                outputs.store(i, r);
+            });
+        }
+    });
+
+    bench("execute_batch,        n = " + size + "\t", n, [&] {
+        soa<int, int> outputs(n);
+        execute_batch(pool, graph(), inputs, outputs);
+    });
+}
+
+int main()
+{
+    thread_pool pool{4};
+    for(std::size_t n : {16, 256, 4096, 65536})
+    {
+        throughput(pool, n);
+    }
+}
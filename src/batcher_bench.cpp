@@ -0,0 +1,93 @@
+#include "../include/orizzonte.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+using namespace orizzonte::node;
+using namespace std::chrono_literals;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+void spin_for(std::chrono::nanoseconds d)
+{
+    const auto end = hr_clock::now() + d;
+    while(hr_clock::now() < end)
+    {
+    }
+}
+
+// Backend whose calls cost 50us, plus 1us per item.
+std::vector<int> backend(std::vector<int> xs)
+{
+    spin_for(50us + 1us * xs.size());
+    for(auto& x : xs)
+    {
+        x += 1;
+    }
+
+    return xs;
+}
+
+constexpr int clients = 8;
+constexpr int requests = 200;
+
+// Every client executes its graph `requests` times, one after the other.
+template <typename MakeGraph>
+void run(const std::string& title, thread_pool& pool, MakeGraph&& make_graph)
+{
+    std::atomic<long long> latency_ns{0};
+    const auto start = hr_clock::now();
+
+    std::vector<std::thread> ts;
+    for(int c = 0; c < clients; ++c)
+    {
+        ts.emplace_back([&, c] {
+            auto graph = make_graph(c);
+            for(int i = 0; i < requests; ++i)
+            {
+                const auto t0 = hr_clock::now();
+                sync_execute(pool, graph, [](int) {});
+                latency_ns += (hr_clock::now() - t0).count();
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(hr_clock::now() - start).count();
+
+    const int total = clients * requests;
+    std::cout << title << " | " << (total / seconds) << " items/s, "
+              << (latency_ns.load() / total / 1000.0) << " us latency\n";
+}
+
+int main()
+{
+    thread_pool pool{4};
+
+    run("one call per item    ", pool, [](int c) {
+        return seq{leaf{[c] { return c; }},
+            leaf{[](int x) { return backend(std::vector<int>{x})[0]; }}};
+    });
+
+    for(auto window : {50us, 200us, 1000us})
+    {
+        // At most `clients` items are in flight: batches are flushed by the
+        // window, and its length is the latency paid for batching.
+        batcher b{in<int>, 64, window,
+            [](std::vector<int> xs) { return backend(std::move(xs)); }};
+
+        run("batcher, window " + std::to_string(window.count()) + "us\t",
+            pool,
+            [&b](int c) { return seq{leaf{[c] { return c; }}, b.ref()}; });
+    }
+}
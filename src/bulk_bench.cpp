@@ -0,0 +1,114 @@
+#include "../include/orizzonte.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 10;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << ((acc / times) / 1000.0) << " ms\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+// Hides `bulk`, so that every child is submitted separately.
+struct single
+{
+    thread_pool& _pool;
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        _pool(FWD(f));
+    }
+
+    bool should_spawn() const noexcept
+    {
+        return _pool.should_spawn();
+    }
+};
+
+// Sub-microsecond unit of work.
+int work(int x)
+{
+    for(volatile int i = 0; i < 50; ++i)
+    {
+        x = x * 31 + i;
+    }
+
+    return x;
+}
+
+/*
+    8x (leaf) --> all, executed by `clients` threads concurrently.
+*/
+template <typename Scheduler>
+void run_graphs(Scheduler& s, int clients, int graphs)
+{
+#define L leaf{[] { return work(1); }}
+
+    std::vector<std::thread> ts;
+    for(int c = 0; c < clients; ++c)
+    {
+        ts.emplace_back([&s, graphs] {
+            for(int i = 0; i < graphs; ++i)
+            {
+                auto f = all{L, L, L, L, L, L, L, L};
+                sync_execute(s, f, [](auto&&) {});
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+#undef L
+}
+
+int main()
+{
+    thread_pool pool;
+
+    for(int k = 0; k < 2; ++k)
+    {
+        for(int clients : {1, 4, 16})
+        {
+            const auto id = std::to_string(clients);
+            constexpr int graphs = 2000;
+
+            bench(id + "\tclients - single", [&] {
+                single s{pool};
+                run_graphs(s, clients, graphs);
+            });
+
+            bench(id + "\tclients - bulk  ",
+                [&] { run_graphs(pool, clients, graphs); });
+        }
+
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,114 @@
+// Requires C++20: g++ -std=c++20 -O2 -I../include coroutine_bench.cpp
+#include "../include/orizzonte.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 10;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << ((acc / times) / 1000.0) << " ms\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::coroutine::co_execute;
+using orizzonte::coroutine::task;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::scoped_int_latch;
+using orizzonte::utility::sync_execute;
+
+// Sub-microsecond unit of work.
+int work(int x)
+{
+    for(volatile int i = 0; i < 50; ++i)
+    {
+        x = x * 31 + i;
+    }
+
+    return x;
+}
+
+#define L leaf{[] { return work(1); }}
+
+/*
+    `requests` graphs of 4x (leaf) --> all. Each blocking request holds one
+    of `clients` threads until its graph completes.
+*/
+void run_blocking(thread_pool& workers, int clients, int requests)
+{
+    scoped_int_latch done{requests};
+
+    {
+        thread_pool client_pool{std::size_t(clients)};
+        for(int i = 0; i < requests; ++i)
+        {
+            client_pool([&] {
+                auto f = all{L, L, L, L};
+                sync_execute(workers, f, [](auto&&) {});
+                done.count_down();
+            });
+        }
+    }
+}
+
+/*
+    Same graphs, each awaited by a coroutine. No thread is blocked while a
+    graph is executing.
+*/
+void run_coroutines(thread_pool& workers, int requests)
+{
+    scoped_int_latch done{requests};
+
+    // Captureless: the coroutine outlives `request`.
+    auto request = co_leaf{[](thread_pool* w) -> task<void> {
+        co_await co_execute(*w, all{L, L, L, L});
+    }};
+
+    for(int i = 0; i < requests; ++i)
+    {
+        request.execute(workers, &workers,
+            [&done](auto&&) { done.count_down(); },
+            orizzonte::utility::noop_v);
+    }
+}
+
+#undef L
+
+int main()
+{
+    thread_pool workers;
+    constexpr int requests = 10000;
+
+    for(int k = 0; k < 2; ++k)
+    {
+        for(int clients : {16, 256})
+        {
+            bench(std::to_string(clients) + "\tclient threads - sync_execute",
+                [&] { run_blocking(workers, clients, requests); });
+        }
+
+        bench("coroutines\t\t - co_execute",
+            [&] { run_coroutines(workers, requests); });
+
+        std::cout << '\n';
+    }
+}
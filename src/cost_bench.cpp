@@ -0,0 +1,116 @@
+#include "../include/orizzonte.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 500;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << (acc / times) << " us\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::utility::sync_execute;
+
+void spin(int us)
+{
+    const auto end = hr_clock::now() + std::chrono::microseconds(us);
+    while(hr_clock::now() < end)
+    {
+    }
+}
+
+/*
+    (HEAVY) \
+    (light) --> all
+    (light) /
+    (light)
+*/
+void b0_skewed(int heavy_us, int light_us)
+{
+    const auto id = std::to_string(heavy_us) + "/" + std::to_string(light_us);
+
+    bench(id + "\tus - skew - unannotated", [&] {
+        auto f = all{leaf{[&] { spin(heavy_us); }},
+            leaf{[&] { spin(light_us); }}, leaf{[&] { spin(light_us); }},
+            leaf{[&] { spin(light_us); }}};
+
+        sync_execute(S{}, f, [](auto&&) {});
+    });
+
+    bench(id + "\tus - skew - annotated  ", [&] {
+        auto f = all{leaf{cost<heavy>, [&] { spin(heavy_us); }},
+            leaf{cost<light>, [&] { spin(light_us); }},
+            leaf{cost<light>, [&] { spin(light_us); }},
+            leaf{cost<light>, [&] { spin(light_us); }}};
+
+        sync_execute(S{}, f, [](auto&&) {});
+    });
+}
+
+/*
+    8x (trivial) --> all
+*/
+void b1_trivial()
+{
+    std::atomic<int> acc{0};
+#define ADD [&acc] { acc.fetch_add(1, std::memory_order_relaxed); }
+
+    bench("trivial - unannotated", [&] {
+        auto f = all{leaf{ADD}, leaf{ADD}, leaf{ADD}, leaf{ADD},
+            leaf{ADD}, leaf{ADD}, leaf{ADD}, leaf{ADD}};
+
+        sync_execute(S{}, f, [](auto&&) {});
+    });
+
+    bench("trivial - annotated  ", [&] {
+        auto f = all{leaf{cost<trivial>, ADD}, leaf{cost<trivial>, ADD},
+            leaf{cost<trivial>, ADD}, leaf{cost<trivial>, ADD},
+            leaf{cost<trivial>, ADD}, leaf{cost<trivial>, ADD},
+            leaf{cost<trivial>, ADD}, leaf{cost<trivial>, ADD}};
+
+        sync_execute(S{}, f, [](auto&&) {});
+    });
+
+#undef ADD
+}
+
+int main()
+{
+    for(int k = 0; k < 2; ++k)
+    {
+        b0_skewed(1000, 100);
+        b0_skewed(1000, 10);
+        b0_skewed(100, 10);
+        b1_trivial();
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,102 @@
+#include "../include/orizzonte.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::steady_clock;
+
+using namespace orizzonte::node;
+using namespace std::chrono_literals;
+using orizzonte::scheduler::deadline_pool;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+void spin(std::chrono::microseconds d)
+{
+    const auto end = hr_clock::now() + d;
+    while(hr_clock::now() < end)
+    {
+    }
+}
+
+auto make_graph()
+{
+    const auto work = [] {
+        return [] {
+            spin(100us);
+            return 0;
+        };
+    };
+
+    return all{leaf{work()}, leaf{work()}, leaf{work()}, leaf{work()}};
+}
+
+constexpr int clients = 16;
+constexpr int requests = 100;
+
+// Every client issues graphs back to back, each with a random relative
+// deadline, and counts the ones completing after it.
+template <typename Execute>
+void run(const std::string& title, Execute&& execute)
+{
+    std::atomic<int> missed{0};
+    std::vector<std::thread> ts;
+
+    for(int c = 0; c < clients; ++c)
+    {
+        ts.emplace_back([&, c] {
+            std::mt19937 rng(c);
+            std::uniform_int_distribution<int> d{1, 20};
+
+            for(int i = 0; i < requests; ++i)
+            {
+                const auto deadline =
+                    hr_clock::now() + std::chrono::milliseconds{d(rng)};
+
+                auto graph = make_graph();
+                execute(deadline, graph);
+
+                if(hr_clock::now() > deadline)
+                {
+                    ++missed;
+                }
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    std::cout << title << ": " << (100.0 * missed / (clients * requests))
+              << "% deadlines missed\n";
+}
+
+int main()
+{
+    {
+        thread_pool p{4};
+        run("fifo", [&](auto, auto& graph) {
+            sync_execute(p, graph, [](auto&&) {});
+        });
+    }
+
+    {
+        deadline_pool p{4, false};
+        run("edf", [&](auto deadline, auto& graph) {
+            sync_execute(p.with_deadline(deadline), graph, [](auto&&) {});
+        });
+    }
+
+    {
+        deadline_pool p{4, true};
+        run("edf, late work demoted", [&](auto deadline, auto& graph) {
+            sync_execute(p.with_deadline(deadline), graph, [](auto&&) {});
+        });
+    }
+}
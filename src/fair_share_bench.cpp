@@ -0,0 +1,112 @@
+#include "../include/orizzonte.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::steady_clock;
+
+using namespace orizzonte::node;
+using namespace std::chrono_literals;
+using orizzonte::scheduler::fair_share_pool;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+void spin(std::chrono::microseconds d)
+{
+    const auto end = hr_clock::now() + d;
+    while(hr_clock::now() < end)
+    {
+    }
+}
+
+auto make_graph()
+{
+    const auto work = [] {
+        return [] {
+            spin(50us);
+            return 0;
+        };
+    };
+
+    return all{leaf{work()}, leaf{work()}, leaf{work()}, leaf{work()}};
+}
+
+// A bursty tenant repeatedly submits fan-outs of 256 computations, while
+// three steady tenants execute small graphs back to back. Reports how many
+// graphs every steady tenant completed, and their p99 latency.
+template <typename Bursty, typename Steady>
+void run(const std::string& title, Bursty&& bursty, Steady&& steady)
+{
+    std::atomic<bool> stop{false};
+
+    std::thread burster{[&] {
+        while(!stop)
+        {
+            std::atomic<int> left{256};
+            bursty().bulk(256, [&](std::size_t) {
+                spin(50us);
+                --left;
+            });
+
+            while(left != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    std::vector<std::vector<double>> latencies(3);
+    std::vector<std::thread> ts;
+    for(int t = 0; t < 3; ++t)
+    {
+        ts.emplace_back([&, t] {
+            const auto end = hr_clock::now() + 1s;
+            while(hr_clock::now() < end)
+            {
+                const auto t0 = hr_clock::now();
+                auto graph = make_graph();
+                sync_execute(steady(t), graph, [](auto&&) {});
+                latencies[t].push_back(std::chrono::duration<double, std::micro>(
+                    hr_clock::now() - t0)
+                                           .count());
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    stop = true;
+    burster.join();
+
+    std::cout << title << ":";
+    for(auto& l : latencies)
+    {
+        std::sort(l.begin(), l.end());
+        std::cout << " [" << l.size() << " graphs, p99 "
+                  << int(l[l.size() * 99 / 100]) << "us]";
+    }
+
+    std::cout << "\n";
+}
+
+int main()
+{
+    {
+        thread_pool p{4};
+        run("thread_pool", [&]() -> auto& { return p; },
+            [&](int) -> auto& { return p; });
+    }
+
+    {
+        fair_share_pool p{4, {1, 1, 1, 1}};
+        run("fair_share_pool", [&]() -> auto& { return p.tenant(0); },
+            [&](int t) -> auto& { return p.tenant(std::size_t(t + 1)); });
+    }
+}
@@ -0,0 +1,155 @@
+#include "../include/orizzonte.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 5;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << ((acc / times) / 1000.0) << " ms\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::chunked_file;
+using orizzonte::utility::mapped_file;
+using orizzonte::utility::sync_execute;
+
+// Per-chunk partial result: number of words and sum of the first CSV column.
+struct partial
+{
+    std::size_t _words{0};
+    long long _sum{0};
+};
+
+partial scan(std::string_view chunk)
+{
+    partial result;
+    bool in_word = false;
+    bool first_column = true;
+    long long value = 0;
+
+    for(const char c : chunk)
+    {
+        const bool separator = c == ',' || c == '\n' || c == ' ';
+        result._words += !separator && !in_word;
+        in_word = !separator;
+
+        if(first_column && c >= '0' && c <= '9')
+        {
+            value = value * 10 + (c - '0');
+        }
+        else if(c == ',')
+        {
+            first_column = false;
+        }
+        else if(c == '\n')
+        {
+            result._sum += value;
+            value = 0;
+            first_column = true;
+        }
+    }
+
+    return result;
+}
+
+partial merge(const std::vector<partial>& ps)
+{
+    return std::accumulate(
+        ps.begin(), ps.end(), partial{}, [](partial a, const partial& b) {
+            return partial{a._words + b._words, a._sum + b._sum};
+        });
+}
+
+std::string make_csv(std::size_t rows)
+{
+    char path[] = "/tmp/orizzonte_ingest_XXXXXX";
+    ::close(::mkstemp(path));
+
+    std::ofstream ofs{path};
+    for(std::size_t i = 0; i < rows; ++i)
+    {
+        ofs << i << ",name" << (i % 97) << ",some free text field\n";
+    }
+
+    return path;
+}
+
+volatile long long sink;
+
+int main()
+{
+    const auto path = make_csv(4'000'000);
+    thread_pool pool;
+
+    for(int k = 0; k < 2; ++k)
+    {
+        bench("ifstream, single-threaded     ", [&] {
+            std::ifstream ifs{path};
+            std::string line;
+            partial p;
+
+            while(std::getline(ifs, line))
+            {
+                line += '\n';
+                const auto q = scan(line);
+                p._words += q._words;
+                p._sum += q._sum;
+            }
+
+            sink = p._sum;
+        });
+
+        bench("mmap, single-threaded         ", [&] {
+            mapped_file f{path.c_str()};
+            sink = scan(f.view())._sum;
+        });
+
+        for(std::size_t chunk : {1u << 16, 1u << 20, 1u << 22})
+        {
+            bench("mmap, fan_out, " + std::to_string(chunk >> 10) +
+                      " KiB chunks\t",
+                [&] {
+                    auto graph = seq{file_chunks(path, chunk),
+                        seq{fan_out{in<chunked_file>, [](std::string_view c) {
+                                return scan(c);
+                            }},
+                            leaf{[](std::vector<partial> ps) {
+                                return merge(ps);
+                            }}}};
+
+                    sync_execute(
+                        pool, graph, [](partial p) { sink = p._sum; });
+                });
+        }
+
+        std::cout << '\n';
+    }
+
+    ::unlink(path.c_str());
+}
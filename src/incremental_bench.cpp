@@ -0,0 +1,103 @@
+#include "../include/orizzonte.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::utility::sync_execute;
+
+constexpr std::size_t groups = 10;
+constexpr std::size_t group_size = 20;
+constexpr std::size_t leaves = groups * group_size;
+
+int data[leaves];
+
+// Roughly 20us of work.
+int work(int x)
+{
+    for(volatile int i = 0; i < 8000; ++i)
+    {
+        x = x * 31 + i;
+    }
+
+    return x;
+}
+
+template <bool Incremental, std::size_t I>
+auto stage()
+{
+    auto source = leaf{[] { return data[I]; }};
+    auto compute = leaf{[](int x) { return work(x); }};
+
+    if constexpr(Incremental)
+    {
+        return seq{std::move(source), incremental{std::move(compute)}};
+    }
+    else
+    {
+        return seq{std::move(source), std::move(compute)};
+    }
+}
+
+template <bool Incremental, std::size_t G, std::size_t... Is>
+auto group(std::index_sequence<Is...>)
+{
+    return all{stage<Incremental, G * group_size + Is>()...};
+}
+
+template <bool Incremental, std::size_t... Gs>
+auto graph(std::index_sequence<Gs...>)
+{
+    return all{
+        group<Incremental, Gs>(std::make_index_sequence<group_size>{})...};
+}
+
+// Changes `percent`% of the inputs before every execution.
+template <typename Graph>
+double run(Graph& g, int percent)
+{
+    constexpr int times = 20;
+    std::mt19937 rng{0};
+    std::uniform_int_distribution<std::size_t> index{0, leaves - 1};
+
+    double acc = 0;
+    for(int t = 0; t < times; ++t)
+    {
+        for(std::size_t i = 0; i < leaves * percent / 100; ++i)
+        {
+            ++data[index(rng)];
+        }
+
+        const auto start = hr_clock::now();
+        sync_execute(inline_scheduler{}, g, [](const auto&) {});
+        acc += std::chrono::duration<double, std::milli>(
+            hr_clock::now() - start)
+                   .count();
+    }
+
+    return acc / times;
+}
+
+int main()
+{
+    auto full = graph<false>(std::make_index_sequence<groups>{});
+    auto inc = graph<true>(std::make_index_sequence<groups>{});
+
+    // Warm-up: fills the caches of the incremental graph.
+    run(inc, 100);
+
+    for(int percent : {1, 10, 50})
+    {
+        const double f = run(full, percent);
+        const double i = run(inc, percent);
+
+        std::cout << percent << "% changed\t| full: " << f
+                  << " ms, incremental: " << i << " ms, speedup: " << (f / i)
+                  << "x\n";
+    }
+}
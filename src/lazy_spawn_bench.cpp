@@ -0,0 +1,96 @@
+#include "../include/orizzonte.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 10;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << ((acc / times) / 1000.0) << " ms\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+// Hides `should_spawn`, so that every child is submitted to the pool.
+struct eager
+{
+    thread_pool& _pool;
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        _pool(FWD(f));
+    }
+};
+
+// Sub-microsecond unit of work.
+int work(int x)
+{
+    for(volatile int i = 0; i < 50; ++i)
+    {
+        x = x * 31 + i;
+    }
+
+    return x;
+}
+
+/*
+    4x (4x (leaf) --> all) --> all, with < 1us of work per leaf.
+*/
+template <typename Scheduler>
+void run_graphs(Scheduler& s, int graphs)
+{
+#define L leaf{[] { return work(1); }}
+#define G all{L, L, L, L}
+
+    for(int i = 0; i < graphs; ++i)
+    {
+        auto f = all{G, G, G, G};
+        sync_execute(s, f, [](auto&&) {});
+    }
+
+#undef G
+#undef L
+}
+
+int main()
+{
+    thread_pool pool;
+
+    for(int k = 0; k < 2; ++k)
+    {
+        for(int graphs : {100, 1000, 10000})
+        {
+            const auto id = std::to_string(graphs);
+
+            bench(id + "\tgraphs - eager", [&] {
+                eager s{pool};
+                run_graphs(s, graphs);
+            });
+
+            bench(id + "\tgraphs - lazy ", [&] { run_graphs(pool, graphs); });
+        }
+
+        std::cout << '\n';
+    }
+}
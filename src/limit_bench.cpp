@@ -0,0 +1,100 @@
+#include "../include/orizzonte.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+using namespace orizzonte::node;
+using namespace std::chrono_literals;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::async_semaphore;
+using orizzonte::utility::sync_execute;
+
+// Simulated backend that degrades under contention: every request spins
+// for longer the more requests are in flight beyond its capacity.
+constexpr int capacity = 4;
+std::atomic<int> in_flight{0};
+
+int backend(int x)
+{
+    const int n = ++in_flight;
+    const int excess = std::max(n - capacity, 0);
+    const auto work = 50us + excess * excess * 10us;
+
+    const auto end = hr_clock::now() + work;
+    while(hr_clock::now() < end)
+    {
+    }
+
+    --in_flight;
+    return x + 1;
+}
+
+constexpr int clients = 16;
+constexpr int requests = 200;
+
+template <typename MakeGraph>
+void run(const std::string& title, MakeGraph&& make_graph)
+{
+    thread_pool pool{4};
+    std::vector<std::vector<double>> latencies(clients);
+    const auto start = hr_clock::now();
+
+    std::vector<std::thread> ts;
+    for(int c = 0; c < clients; ++c)
+    {
+        ts.emplace_back([&, c] {
+            for(int i = 0; i < requests; ++i)
+            {
+                const auto t0 = hr_clock::now();
+                auto graph = make_graph(i);
+                sync_execute(pool, graph, [](int) {});
+                latencies[c].push_back(
+                    std::chrono::duration<double, std::micro>(
+                        hr_clock::now() - t0)
+                        .count());
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(hr_clock::now() - start).count();
+
+    std::vector<double> all;
+    for(auto& l : latencies)
+    {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+
+    std::sort(all.begin(), all.end());
+
+    std::cout << title << ": " << int(clients * requests / seconds)
+              << " req/s, p50 " << int(all[all.size() / 2]) << "us, p99 "
+              << int(all[all.size() * 99 / 100]) << "us\n";
+}
+
+int main()
+{
+    run("unlimited", [](int i) {
+        return seq{leaf{[i] { return i; }}, leaf{[](int x) { return backend(x); }}};
+    });
+
+    for(int n : {1, 2, 4, 8})
+    {
+        async_semaphore sem{std::size_t(n)};
+        run("limit " + std::to_string(n), [&sem](int i) {
+            return seq{leaf{[i] { return i; }},
+                limit{sem, leaf{[](int x) { return backend(x); }}}};
+        });
+    }
+}
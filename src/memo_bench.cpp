@@ -0,0 +1,109 @@
+#include "../include/orizzonte.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::utility::clock_eviction;
+using orizzonte::utility::concurrent_cache;
+using orizzonte::utility::lru_eviction;
+using orizzonte::utility::sync_execute;
+
+constexpr int keys = 1024;
+constexpr int operations = 1000000;
+volatile int sink;
+
+template <typename TF>
+void bench(const std::string& title, int ops, TF&& f)
+{
+    const auto start = hr_clock::now();
+    f();
+
+    const double ns =
+        std::chrono::duration<double, std::nano>(hr_clock::now() - start)
+            .count();
+
+    std::cout << title << " | " << (ns / ops) << " ns/op\n";
+}
+
+// Cost of executing a graph ending with a `leaf`, or with a `memo` that
+// always hits.
+void hit_path()
+{
+    bench("plain leaf            ", operations, [] {
+        for(int i = 0; i < operations; ++i)
+        {
+            auto graph = seq{leaf{[i] { return i % keys; }},
+                leaf{[](int x) { return x * 2; }}};
+
+            sync_execute(inline_scheduler{}, graph, [](int r) { sink = r; });
+        }
+    });
+
+    concurrent_cache<int, int> cache{keys * 64};
+    for(int k = 0; k < keys; ++k)
+    {
+        cache.insert(k, k * 2);
+    }
+
+    bench("memo, hit             ", operations, [&cache] {
+        for(int i = 0; i < operations; ++i)
+        {
+            auto graph = seq{leaf{[i] { return i % keys; }},
+                memo{cache, leaf{[](int x) { return x * 2; }}}};
+
+            sync_execute(inline_scheduler{}, graph, [](int r) { sink = r; });
+        }
+    });
+}
+
+// Lookups per second with `threads` threads hitting the cache.
+template <typename Policy>
+void scaling(const std::string& name, int threads)
+{
+    concurrent_cache<int, int, Policy> cache{keys * 64, 8};
+    for(int k = 0; k < keys; ++k)
+    {
+        cache.insert(k, k);
+    }
+
+    const int per_thread = operations / threads;
+
+    bench(name + ", " + std::to_string(threads) + " threads\t", operations,
+        [&] {
+            std::vector<std::thread> ts;
+            for(int t = 0; t < threads; ++t)
+            {
+                ts.emplace_back([&cache, per_thread, t] {
+                    int acc = 0;
+                    for(int i = 0; i < per_thread; ++i)
+                    {
+                        acc += *cache.find((i * 7 + t) % keys);
+                    }
+
+                    sink = acc;
+                });
+            }
+
+            for(auto& t : ts)
+            {
+                t.join();
+            }
+        });
+}
+
+int main()
+{
+    hit_path();
+
+    for(int threads : {1, 2, 4, 8})
+    {
+        scaling<lru_eviction>("lru  ", threads);
+        scaling<clock_eviction>("clock", threads);
+    }
+}
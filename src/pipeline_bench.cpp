@@ -0,0 +1,135 @@
+#include "../include/orizzonte.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 5;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << ((acc / times) / 1000.0) << " ms\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+// Roughly a microsecond of work.
+int work(int x)
+{
+    for(volatile int i = 0; i < 200; ++i)
+    {
+        x = x * 31 + i;
+    }
+
+    return x;
+}
+
+std::vector<int> input(int n)
+{
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+constexpr int items = 100000;
+volatile long long sink;
+
+void throughput(thread_pool& pool)
+{
+    const auto xs = input(items);
+
+    bench("loop, single-threaded    ", [&] {
+        long long acc = 0;
+        for(int x : xs)
+        {
+            acc += work(work(x) + 1);
+        }
+
+        sink = acc;
+    });
+
+    for(std::size_t capacity : {1, 16, 256})
+    {
+        bench("pipeline, capacity " + std::to_string(capacity) + "\t", [&] {
+            long long acc = 0;
+            auto graph = seq{leaf{[&xs] { return xs; }},
+                pipeline{in<std::vector<int>>, capacity,
+                    serial([](int x) { return work(x); }),
+                    parallel([](int x) { return work(x + 1); }),
+                    serial([&acc](int x) { acc += x; })}};
+
+            sync_execute(pool, graph, [] {});
+            sink = acc;
+        });
+    }
+}
+
+void memory_ceiling()
+{
+    // More workers than cores, so that the producer can run ahead.
+    thread_pool pool{4};
+
+    for(std::size_t capacity : {4, 64, 1024})
+    {
+        std::atomic<int> entered{0};
+        std::atomic<int> left{0};
+        int max_in_flight = 0;
+
+        auto graph = seq{leaf{[] { return input(5000); }},
+            pipeline{in<std::vector<int>>, capacity,
+                serial([&](int x) {
+                    max_in_flight = std::max(max_in_flight, ++entered - left);
+                    return std::vector<char>(1024, char(x));
+                }),
+                serial([&](std::vector<char>) {
+                    std::this_thread::sleep_for(
+                        std::chrono::microseconds(20));
+                    ++left;
+                })}};
+
+        const auto start = hr_clock::now();
+        sync_execute(pool, graph, [] {});
+        const auto dur = hr_clock::now() - start;
+
+        std::cout << "slow sink, capacity " << capacity << "\t| "
+                  << max_in_flight << " items (1 KiB each) in flight max, "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(
+                         dur)
+                         .count()
+                  << " ms\n";
+    }
+}
+
+int main()
+{
+    thread_pool pool;
+
+    for(int k = 0; k < 2; ++k)
+    {
+        throughput(pool);
+        memory_ceiling();
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,94 @@
+#include "../include/orizzonte.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+using namespace orizzonte::node;
+using namespace std::chrono_literals;
+using orizzonte::scheduler::priority_pool;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+void spin(std::chrono::microseconds d)
+{
+    const auto end = hr_clock::now() + d;
+    while(hr_clock::now() < end)
+    {
+    }
+}
+
+auto make_graph(std::chrono::microseconds d)
+{
+    const auto work = [d] {
+        return [d] {
+            spin(d);
+            return 0;
+        };
+    };
+
+    return all{leaf{work()}, leaf{work()}, leaf{work()}, leaf{work()}};
+}
+
+constexpr int requests = 300;
+
+// Low-priority submitters keep the pool saturated, while one client
+// measures the latency of interactive graphs.
+template <typename Low, typename High>
+void run(const std::string& title, Low& low, High& high)
+{
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> flooders;
+    for(int i = 0; i < 4; ++i)
+    {
+        flooders.emplace_back([&] {
+            while(!stop)
+            {
+                auto graph = make_graph(200us);
+                sync_execute(low, graph, [](auto&&) {});
+            }
+        });
+    }
+
+    std::vector<double> latencies;
+    for(int i = 0; i < requests; ++i)
+    {
+        const auto t0 = hr_clock::now();
+        auto graph = make_graph(20us);
+        sync_execute(high, graph, [](auto&&) {});
+        latencies.push_back(
+            std::chrono::duration<double, std::micro>(hr_clock::now() - t0)
+                .count());
+
+        std::this_thread::sleep_for(1ms);
+    }
+
+    stop = true;
+    for(auto& t : flooders)
+    {
+        t.join();
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << title << ": p50 " << int(latencies[requests / 2])
+              << "us, p99 " << int(latencies[requests * 99 / 100]) << "us\n";
+}
+
+int main()
+{
+    {
+        thread_pool p{4};
+        run("thread_pool", p, p);
+    }
+
+    {
+        priority_pool p{4, 2};
+        run("priority_pool", p.at(1), p.at(0));
+    }
+}
@@ -0,0 +1,220 @@
+#include "../include/orizzonte.hpp"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 3;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << ((acc / times) / 1000.0) << " ms\n";
+}
+
+using orizzonte::utility::eventcount;
+using orizzonte::utility::mpmc_queue;
+using orizzonte::utility::spsc_queue;
+
+constexpr int items = 1 << 20;
+constexpr std::size_t capacity = 1024;
+
+// Baseline: bounded `std::deque` behind a mutex.
+class locked_queue
+{
+private:
+    std::mutex _mutex;
+    std::deque<int> _items;
+
+public:
+    explicit locked_queue(std::size_t)
+    {
+    }
+
+    bool try_push(int x)
+    {
+        std::lock_guard l{_mutex};
+        if(_items.size() == capacity)
+        {
+            return false;
+        }
+
+        _items.push_back(x);
+        return true;
+    }
+
+    std::optional<int> try_pop()
+    {
+        std::lock_guard l{_mutex};
+        if(_items.empty())
+        {
+            return std::nullopt;
+        }
+
+        const int result = _items.front();
+        _items.pop_front();
+        return result;
+    }
+};
+
+// Producers and consumers retry with `yield` on a full or empty queue.
+template <typename Queue>
+void run_spinning(int producers, int consumers)
+{
+    Queue q{capacity};
+    std::atomic<int> received{0};
+    std::vector<std::thread> threads;
+
+    for(int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&] {
+            for(int i = 0; i < items / producers; ++i)
+            {
+                while(!q.try_push(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for(int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            while(received.load(std::memory_order_relaxed) < items)
+            {
+                if(q.try_pop())
+                {
+                    received.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for(auto& t : threads)
+    {
+        t.join();
+    }
+}
+
+// Consumers park on an `eventcount` when the queue stays empty for a while.
+void run_parking(int producers, int consumers)
+{
+    mpmc_queue<int> q{capacity};
+    eventcount not_empty;
+    std::atomic<int> received{0};
+    std::vector<std::thread> threads;
+
+    for(int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&] {
+            for(int i = 0; i < items / producers; ++i)
+            {
+                while(!q.try_push(i))
+                {
+                    std::this_thread::yield();
+                }
+
+                not_empty.notify_one();
+            }
+        });
+    }
+
+    // Returns `true` when the last item was received.
+    auto pop = [&] {
+        for(int spin = 0; spin < 64; ++spin)
+        {
+            if(q.try_pop())
+            {
+                return received.fetch_add(1) + 1 == items;
+            }
+
+            std::this_thread::yield();
+        }
+
+        return false;
+    };
+
+    for(int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            while(true)
+            {
+                if(pop())
+                {
+                    not_empty.notify_all();
+                    return;
+                }
+
+                const auto key = not_empty.prepare_wait();
+                if(received.load() >= items)
+                {
+                    not_empty.cancel_wait();
+                    return;
+                }
+
+                if(q.try_pop())
+                {
+                    not_empty.cancel_wait();
+                    if(received.fetch_add(1) + 1 == items)
+                    {
+                        not_empty.notify_all();
+                        return;
+                    }
+
+                    continue;
+                }
+
+                not_empty.wait(key);
+            }
+        });
+    }
+
+    for(auto& t : threads)
+    {
+        t.join();
+    }
+}
+
+int main()
+{
+    bench("1:1   spsc            ",
+        [] { run_spinning<spsc_queue<int>>(1, 1); });
+
+    for(int n : {1, 2, 4, 8, 16})
+    {
+        const auto id = std::to_string(n) + ":" + std::to_string(n);
+
+        bench(id + "\tmutex + deque ",
+            [n] { run_spinning<locked_queue>(n, n); });
+
+        bench(id + "\tmpmc          ",
+            [n] { run_spinning<mpmc_queue<int>>(n, n); });
+
+        bench(id + "\tmpmc + parking", [n] { run_parking(n, n); });
+    }
+}
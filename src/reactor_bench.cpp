@@ -0,0 +1,183 @@
+#include "../include/orizzonte.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::reactor;
+using orizzonte::utility::scoped_int_latch;
+using orizzonte::utility::sync_execute;
+
+constexpr std::size_t message_size = 64;
+constexpr int batch = 8;
+
+// Echoes everything it receives, on the reactor, without using graphs.
+struct echo_server
+{
+    struct connection
+    {
+        int _fd;
+        char _buffer[message_size];
+    };
+
+    reactor& _r;
+    int _listener;
+
+    void accept_loop()
+    {
+        _r.accept(_listener, [this](int fd) {
+            if(fd >= 0)
+            {
+                serve(new connection{fd, {}});
+                accept_loop();
+            }
+        });
+    }
+
+    void serve(connection* c)
+    {
+        _r.read(c->_fd, c->_buffer, message_size, [this, c](ssize_t n) {
+            if(n <= 0)
+            {
+                ::close(c->_fd);
+                delete c;
+                return;
+            }
+
+            _r.write(c->_fd, c->_buffer, std::size_t(n),
+                [this, c](ssize_t) { serve(c); });
+        });
+    }
+};
+
+// 8x (write --> read) --> all, over 8 client connections.
+auto make_echo_graph(reactor& r, const int* fds, char* buffers)
+{
+    static const char message[message_size]{};
+
+#define ECHO(i)                                                 \
+    seq                                                         \
+    {                                                           \
+        io::write(r, fds[i], message, message_size),            \
+            io::read(r, fds[i], buffers + i * message_size,     \
+                message_size)                                   \
+    }
+
+    return all{ECHO(0), ECHO(1), ECHO(2), ECHO(3), ECHO(4), ECHO(5),
+        ECHO(6), ECHO(7)};
+
+#undef ECHO
+}
+
+// 8x (connect) --> all.
+auto make_connect_graph(reactor& r, const sockaddr_in& address)
+{
+#define C io::connect(r, address)
+    return all{C, C, C, C, C, C, C, C};
+#undef C
+}
+
+template <typename Tuple, std::size_t... Is>
+void append(std::vector<int>& fds, Tuple& t, std::index_sequence<Is...>)
+{
+    (fds.push_back(orizzonte::get<Is>(t)), ...);
+}
+
+int main()
+{
+    rlimit limit;
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+
+    // Both ends of every connection live in this process.
+    const int connections = std::min<int>(
+        10000, (int(limit.rlim_cur) - 64) / 2 / batch * batch);
+
+    reactor r;
+
+    const int listener =
+        ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t length = sizeof(address);
+    ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    ::listen(listener, SOMAXCONN);
+    ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+
+    echo_server server{r, listener};
+    server.accept_loop();
+
+    // Connect in waves, so that the listen backlog does not overflow.
+    std::vector<int> fds;
+    while(int(fds.size()) < connections)
+    {
+        auto g = make_connect_graph(r, address);
+        sync_execute(r, g, [&fds](auto x) {
+            append(fds, x, std::make_index_sequence<batch>{});
+        });
+    }
+
+    if(std::any_of(fds.begin(), fds.end(), [](int fd) { return fd < 0; }))
+    {
+        std::cout << "connection failed\n";
+        return 1;
+    }
+
+    std::cout << connections << " connections\n";
+
+    std::vector<char> buffers(fds.size() * message_size);
+    using graph_type = decltype(make_echo_graph(r, nullptr, nullptr));
+
+    std::vector<std::unique_ptr<graph_type>> graphs;
+    for(int i = 0; i < connections; i += batch)
+    {
+        graphs.emplace_back(std::make_unique<graph_type>(make_echo_graph(
+            r, fds.data() + i, buffers.data() + i * message_size)));
+    }
+
+    constexpr int rounds = 10;
+    for(int k = 0; k < 2; ++k)
+    {
+        const auto start = hr_clock::now();
+
+        for(int round = 0; round < rounds; ++round)
+        {
+            // Every connection has a request in flight.
+            scoped_int_latch l{int(graphs.size())};
+            for(auto& g : graphs)
+            {
+                g->execute(r, orizzonte::utility::nothing_v,
+                    [&l](auto&&) { l.count_down(); }, [] {});
+            }
+        }
+
+        const auto dur = hr_clock::now() - start;
+        const auto us =
+            std::chrono::duration_cast<std::chrono::microseconds>(dur).count();
+
+        const double echoes = double(connections) * rounds;
+        std::cout << "echo | " << (us / 1000.0) << " ms | "
+                  << (echoes / (us / 1e6)) << " echoes/s | "
+                  << (double(us) / rounds) << " us/round\n";
+    }
+
+    for(int fd : fds)
+    {
+        ::close(fd);
+    }
+
+    ::close(listener);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
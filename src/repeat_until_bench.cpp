@@ -0,0 +1,77 @@
+#include "../include/orizzonte.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 5;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << ((acc / times) / 1000.0) << " ms\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+constexpr int iterations = 10000;
+volatile int sink;
+
+// A parallel body, whose state and signals are paid for once per iteration
+// in both cases.
+auto body()
+{
+    return seq{all{leaf{[](int x) { return x + 1; }},
+                   leaf{[](int x) { return x * 2; }}},
+        leaf{[](const orizzonte::utility::cache_aligned_tuple<int, int>& r) {
+            return orizzonte::get<0>(r) + (orizzonte::get<1>(r) & 1);
+        }}};
+}
+
+template <typename Scheduler>
+void iterate(const std::string& name, Scheduler&& s)
+{
+    bench(name + ", external loop\t", [&] {
+        int x = 0;
+        auto graph = seq{leaf{[&x] { return x; }}, body()};
+
+        for(int i = 0; i < iterations; ++i)
+        {
+            sync_execute(s, graph, [&x](int r) { x = r; });
+        }
+
+        sink = x;
+    });
+
+    bench(name + ", repeat_until\t", [&] {
+        auto graph = seq{leaf{[] { return 0; }},
+            repeat_until{body(), [](int x) { return x == iterations; }}};
+
+        sync_execute(s, graph, [](int r) { sink = r; });
+    });
+}
+
+int main()
+{
+    iterate("inline     ", inline_scheduler{});
+
+    thread_pool pool{4};
+    iterate("thread_pool", pool);
+}
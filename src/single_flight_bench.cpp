@@ -0,0 +1,98 @@
+#include "../include/orizzonte.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+using namespace orizzonte::node;
+using namespace std::chrono_literals;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+// Keys in `[0, n)` following a Zipf distribution with exponent `s`.
+std::vector<int> zipf_keys(int n, double s, int count, unsigned seed)
+{
+    std::vector<double> cdf(n);
+    double acc = 0;
+    for(int k = 0; k < n; ++k)
+    {
+        acc += 1.0 / std::pow(k + 1, s);
+        cdf[k] = acc;
+    }
+
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<double> d{0, acc};
+
+    std::vector<int> result(count);
+    for(auto& x : result)
+    {
+        x = int(std::lower_bound(cdf.begin(), cdf.end(), d(rng)) - cdf.begin());
+    }
+
+    return result;
+}
+
+// Simulated cache miss: an expensive lookup of the value of a key.
+std::atomic<int> lookups{0};
+int lookup(int key)
+{
+    ++lookups;
+    std::this_thread::sleep_for(200us);
+    return key * 2;
+}
+
+constexpr int clients = 16;
+constexpr int requests = 200;
+
+template <typename MakeGraph>
+void run(const std::string& title, MakeGraph&& make_graph)
+{
+    lookups = 0;
+    thread_pool pool{4};
+    const auto start = hr_clock::now();
+
+    std::vector<std::thread> ts;
+    for(int c = 0; c < clients; ++c)
+    {
+        ts.emplace_back([&, c] {
+            for(int key : zipf_keys(1000, 1.1, requests, c))
+            {
+                auto graph = make_graph(key);
+                sync_execute(pool, graph, [](int) {});
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(hr_clock::now() - start).count();
+
+    std::cout << title << " | " << (clients * requests / seconds)
+              << " requests/s, " << lookups.load() << " lookups\n";
+}
+
+int main()
+{
+    run("plain leaf   ", [](int key) {
+        return seq{leaf{[key] { return key; }},
+            leaf{[](int k) { return lookup(k); }}};
+    });
+
+    single_flight f{in<int>, [](int k) { return k; },
+        [](int k) { return lookup(k); }};
+
+    run("single_flight", [&f](int key) {
+        return seq{leaf{[key] { return key; }}, f.ref()};
+    });
+}
@@ -0,0 +1,94 @@
+#include "../include/orizzonte.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using hr_clock = std::chrono::high_resolution_clock;
+
+template <typename TF>
+void bench(const std::string& title, TF&& f)
+{
+    constexpr int times = 5;
+    double acc = 0;
+
+    for(int i(0); i < times; ++i)
+    {
+        const auto start = hr_clock::now();
+        {
+            f();
+        }
+
+        const auto dur = hr_clock::now() - start;
+        acc += std::chrono::duration_cast<std::chrono::microseconds>(dur)
+                   .count();
+    }
+
+    std::cout << title << " | " << ((acc / times) / 1000.0) << " ms\n";
+}
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+// Children wait on an external resource for a skewed amount of time, as
+// requests to replicas with different latencies would.
+template <int Ms>
+auto request()
+{
+    return leaf{[] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(Ms));
+        return Ms;
+    }};
+}
+
+// Roughly a millisecond of work per result.
+volatile long long sink;
+void process(int x)
+{
+    long long acc = x;
+    for(int i = 0; i < 400000; ++i)
+    {
+        acc = acc * 31 + i;
+    }
+
+    sink = acc;
+}
+
+using results =
+    orizzonte::utility::cache_aligned_tuple<int, int, int, int, int, int>;
+
+void latency(thread_pool& pool)
+{
+    bench("all, then leaf loop ", [&] {
+        auto graph = seq{all{request<1>(), request<4>(), request<8>(),
+                             request<12>(), request<16>(), request<20>()},
+            leaf{[](const results& r) {
+                process(get<0>(r));
+                process(get<1>(r));
+                process(get<2>(r));
+                process(get<3>(r));
+                process(get<4>(r));
+                process(get<5>(r));
+            }}};
+
+        sync_execute(pool, graph, [] {});
+    });
+
+    bench("when_each           ", [&] {
+        auto graph = when_each{[](auto, int x) { process(x); }, request<1>(),
+            request<4>(), request<8>(), request<12>(), request<16>(),
+            request<20>()};
+
+        sync_execute(pool, graph, [] {});
+    });
+}
+
+int main()
+{
+    // End-to-end latency: `when_each` overlaps the processing of early
+    // results with the slower children, instead of waiting for all of them.
+    thread_pool pool{8};
+    latency(pool);
+}
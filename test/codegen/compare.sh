@@ -0,0 +1,46 @@
+#!/bin/sh
+# Copyright (c) 2017 Vittorio Romeo
+# MIT License |  https://opensource.org/licenses/MIT
+# http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+# Usage: compare.sh <compiler> <include dir> <source>
+#
+# Compiles <source> with optimizations and checks that every `graph_<name>`
+# function disassembles to the same instructions as `hand_<name>`.
+
+set -e
+
+CXX="$1"
+INCLUDE="$2"
+SRC="$3"
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+"$CXX" -std=c++1z -O2 -DNDEBUG -I"$INCLUDE" -I"$(dirname "$SRC")/.." \
+    -c "$SRC" -o "$TMP/codegen.o"
+
+objdump -d --no-show-raw-insn "$TMP/codegen.o" > "$TMP/codegen.s"
+
+# Prints the instructions of function $1, without addresses and padding.
+body()
+{
+    awk -v fn="<$1>:" '$2 == fn { p = 1; next } p && /^$/ { exit } p' \
+        "$TMP/codegen.s" | cut -f2- | grep -v '^nop\|^xchg\|^data16\|^int3'
+}
+
+FAILED=0
+for name in $(sed -n 's/^.*<graph_\([a-z_0-9]*\)>:$/\1/p' "$TMP/codegen.s"); do
+    body "graph_$name" > "$TMP/graph"
+    body "hand_$name" > "$TMP/hand"
+
+    if [ ! -s "$TMP/graph" ] || ! cmp -s "$TMP/graph" "$TMP/hand"; then
+        echo "codegen mismatch: graph_$name"
+        diff "$TMP/graph" "$TMP/hand" || true
+        FAILED=1
+    else
+        echo "ok: graph_$name"
+    fi
+done
+
+exit $FAILED
@@ -0,0 +1,70 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+// Every `graph_<name>` function executes a graph on `inline_scheduler`, and
+// must compile to the same instructions as the equivalent hand-written
+// `hand_<name>` function. See `compare.sh`.
+
+#include "../test_utils.hpp"
+#include <orizzonte.hpp>
+
+#define CODEGEN_FN extern "C" __attribute__((noinline))
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::utility::sync_execute;
+
+CODEGEN_FN int graph_seq(int x)
+{
+    int r;
+    auto g = leaf{[x] { return x + 1; }}.then([](int y) { return y * 2; });
+    sync_execute(inline_scheduler{}, g, [&r](int v) { r = v; });
+    return r;
+}
+
+CODEGEN_FN int hand_seq(int x)
+{
+    return (x + 1) * 2;
+}
+
+CODEGEN_FN int graph_all(int x)
+{
+    int r;
+    auto g = all{leaf{[x] { return x + 1; }}, leaf{[x] { return x * 2; }}};
+    sync_execute(inline_scheduler{}, g,
+        [&r](auto v) { r = get<0>(v) + get<1>(v); });
+    return r;
+}
+
+CODEGEN_FN int hand_all(int x)
+{
+    return (x + 1) + x * 2;
+}
+
+CODEGEN_FN int graph_nested(int x)
+{
+    int r;
+    auto g = all{leaf{[x] { return x + 1; }}.then([](int y) { return y * 3; }),
+        leaf{[x] { return x - 1; }}};
+    sync_execute(inline_scheduler{}, g,
+        [&r](auto v) { r = get<0>(v) * get<1>(v); });
+    return r;
+}
+
+CODEGEN_FN int hand_nested(int x)
+{
+    // The cheaper child is executed first.
+    return (x - 1) * (x + 1) * 3;
+}
+
+TEST_MAIN()
+{
+    for(int x : {-3, 0, 1, 42})
+    {
+        EXPECT_EQ(graph_seq(x), hand_seq(x));
+        EXPECT_EQ(graph_all(x), hand_all(x));
+        EXPECT_EQ(graph_nested(x), hand_nested(x));
+    }
+}
@@ -0,0 +1,165 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <orizzonte.hpp>
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <mutex>
+#include <thread>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::coroutine::co_execute;
+using orizzonte::coroutine::resume_on;
+using orizzonte::coroutine::task;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+// Resumes its waiter when set, from the thread that sets it.
+class event
+{
+private:
+    std::mutex _mtx;
+    bool _set{false};
+    std::coroutine_handle<> _waiter;
+
+    struct awaiter
+    {
+        event& _e;
+
+        bool await_ready() noexcept
+        {
+            std::scoped_lock lk{_e._mtx};
+            return _e._set;
+        }
+
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            std::scoped_lock lk{_e._mtx};
+            _e._waiter = h;
+            return !_e._set;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+public:
+    awaiter operator co_await() noexcept
+    {
+        return awaiter{*this};
+    }
+
+    void set()
+    {
+        std::coroutine_handle<> waiter;
+
+        {
+            std::scoped_lock lk{_mtx};
+            _set = true;
+            waiter = std::exchange(_waiter, {});
+        }
+
+        if(waiter)
+        {
+            waiter.resume();
+        }
+    }
+};
+
+void t0()
+{
+    // `co_await` a graph executed on a pool.
+    thread_pool p{2};
+
+    auto root = co_leaf{[&p]() -> task<int> {
+        auto graph = all{leaf{[] { return 1; }}, leaf{[] { return 2; }},
+            leaf{[] { return 3; }}};
+
+        auto r = co_await co_execute(p, graph);
+        co_return get<0>(r) + get<1>(r) + get<2>(r);
+    }};
+
+    sync_execute(p, root, [](int r) { EXPECT_EQ(r, 6); });
+}
+
+void t1()
+{
+    // Graphs completing inline resume the coroutine without a hop.
+    inline_scheduler s;
+    int resumed_on_stack = 0;
+
+    auto root = co_leaf{[&]() -> task<void> {
+        co_await co_execute(s, leaf{[] { return 0; }}
+                                   .then([](int x) { return x + 1; }));
+        ++resumed_on_stack;
+
+        const int x = co_await co_execute(s, leaf{[] { return 41; }});
+        EXPECT_EQ(x, 41);
+        ++resumed_on_stack;
+    }};
+
+    sync_execute(s, root, [] {});
+    EXPECT_EQ(resumed_on_stack, 2);
+}
+
+void t2()
+{
+    // Suspended coroutine leaves do not hold a worker: with a single worker,
+    // the leaf setting the event can run while the other one waits for it.
+    thread_pool p{1};
+    event e;
+
+    auto graph = all{
+        co_leaf{[&e]() -> task<int> {
+            co_await e;
+            co_return 1;
+        }},
+        seq{leaf{[] { return 2; }}, leaf{[&e](int x) {
+            e.set();
+            return x;
+        }}}};
+
+    sync_execute(p, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 1);
+        EXPECT_EQ(get<1>(r), 2);
+    });
+}
+
+void t3()
+{
+    // Coroutine leaves receive the output of the previous node.
+    thread_pool p{2};
+
+    auto graph = leaf{[] { return 20; }}.then(co_leaf{[&p](int x) -> task<int> {
+        co_await resume_on(p);
+        co_return x * 2 + 2;
+    }});
+
+    for(int i = 0; i < 100; ++i)
+    {
+        sync_execute(p, graph, [](int r) { EXPECT_EQ(r, 42); });
+    }
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
+
+#else
+
+TEST_MAIN()
+{
+}
+
+#endif
@@ -0,0 +1,184 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <chrono>
+#include <thread>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::event_loop;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+// Completes `done` with `x` from a separate thread.
+template <typename T, typename Done>
+void complete_later(T x, Done&& done)
+{
+    std::thread{[x, done = std::move(done)]() mutable { done(x); }}.detach();
+}
+
+// `Tag` makes the types of the returned leaves distinct.
+template <int Tag = 0>
+auto make_async(int x)
+{
+    return async_leaf{
+        out<int>, [x](auto done) { complete_later(x, std::move(done)); }};
+}
+
+auto f_sync0 = [] { return 0; };
+auto f_sync1 = [](int) { return 0; };
+using l_sync0 = decltype(leaf{std::move(f_sync0)});
+using l_sync1 = decltype(leaf{std::move(f_sync1)});
+using l_async = decltype(make_async(0));
+
+static_assert(l_sync0::synchronous());
+static_assert(!l_async::synchronous());
+static_assert(seq<l_sync0, l_sync1>::synchronous());
+static_assert(!seq<l_async, l_sync1>::synchronous());
+static_assert(!all<l_async, l_sync0>::synchronous());
+
+void t0()
+{
+    auto graph = seq{make_async(20), leaf{[](int x) { return x + 1; }}};
+    sync_execute(S{}, graph, [](int r) { EXPECT_EQ(r, 21); });
+}
+
+void t1()
+{
+    // Inline schedulers still wait for asynchronous completions.
+    auto graph = all{make_async(1), leaf{[] { return 2; }}};
+
+    for(int i = 0; i < 100; ++i)
+    {
+        sync_execute(inline_scheduler{}, graph, [](auto r) {
+            EXPECT_EQ(get<0>(r), 1);
+            EXPECT_EQ(get<1>(r), 2);
+        });
+    }
+}
+
+void t2()
+{
+    // The input of the leaf is passed before the completion handle.
+    auto graph = seq{leaf{[] { return 20; }},
+        async_leaf{in<int>, out<int>, [](int x, auto done) {
+            complete_later(x * 2 + 2, std::move(done));
+        }}};
+
+    sync_execute(S{}, graph, [](int r) { EXPECT_EQ(r, 42); });
+}
+
+void t3()
+{
+    // Pending asynchronous leaves do not hold a worker: with a single
+    // worker, the leaf producing the value can run while the other one
+    // waits for it.
+    thread_pool p{1};
+    std::atomic<int> value{0};
+
+    auto graph = all{
+        async_leaf{out<int>,
+            [&value](auto done) {
+                std::thread{[&value, done = std::move(done)]() mutable {
+                    while(value.load() == 0)
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    done(value.load());
+                }}.detach();
+            }},
+        leaf{[&value] { value = 42; }}};
+
+    sync_execute(p, graph, [](auto r) { EXPECT_EQ(get<0>(r), 42); });
+}
+
+void t4()
+{
+    auto graph = any{make_async<0>(1), make_async<1>(1)};
+    sync_execute(S{}, graph, [](auto r) { EXPECT_EQ(get<int>(r), 1); });
+
+    // Completions may also happen synchronously.
+    auto sync_graph =
+        async_leaf{out<void>, [](auto done) { done(); }};
+
+    bool called = false;
+    sync_execute(inline_scheduler{}, sync_graph, [&called] { called = true; });
+    EXPECT(called);
+}
+
+void t5()
+{
+    // Single-threaded schedulers are driven until completions from other
+    // threads deliver every signal.
+    event_loop l;
+
+    auto graph = all{make_async(1), leaf{[] { return 2; }},
+        leaf{[] { return 3; }}};
+
+    int calls = 0;
+    sync_execute(l, graph, [&calls](auto r) {
+        EXPECT_EQ(get<0>(r), 1);
+        EXPECT_EQ(get<2>(r), 3);
+        ++calls;
+    });
+
+    EXPECT_EQ(calls, 1);
+
+    // Completions on the thread running the loop.
+    auto graph2 = all{leaf{[] { return 4; }},
+        async_leaf{out<int>, [](auto done) { done(5); }}};
+
+    sync_execute(l, graph2, [](auto r) {
+        EXPECT_EQ(get<0>(r) + get<1>(r), 9);
+    });
+}
+
+void t6()
+{
+    // Delayed completions from other threads wake the loop up.
+    event_loop l;
+
+    auto graph = seq{async_leaf{out<int>,
+                         [](auto done) {
+                             std::thread{[done = std::move(done)]() mutable {
+                                 std::this_thread::sleep_for(
+                                     std::chrono::milliseconds(100));
+                                 done(10);
+                             }}.detach();
+                         }},
+        all{leaf{[](int x) { return x + 1; }},
+            leaf{[](int x) { return x + 2; }}}};
+
+    sync_execute(l, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 11);
+        EXPECT_EQ(get<1>(r), 12);
+    });
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+    t5();
+    t6();
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::node;
+using namespace std::chrono_literals;
+using orizzonte::get;
+using orizzonte::scheduler::event_loop;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+auto doubling(std::atomic<int>& calls, std::atomic<int>& items)
+{
+    return [&calls, &items](std::vector<int> xs) {
+        ++calls;
+        items += static_cast<int>(xs.size());
+
+        for(auto& x : xs)
+        {
+            x *= 2;
+        }
+
+        return xs;
+    };
+}
+
+void t0()
+{
+    // Concurrent executions filling a shard are flushed together.
+    std::atomic<int> calls{0};
+    std::atomic<int> items{0};
+
+    batcher b{in<int>, 8, 10s, doubling(calls, items), 1};
+
+    std::vector<std::thread> ts;
+    for(int i = 0; i < 8; ++i)
+    {
+        ts.emplace_back([&b, i] {
+            auto graph = seq{leaf{[i] { return i; }}, b.ref()};
+            sync_execute(inline_scheduler{}, graph,
+                [i](int r) { EXPECT_EQ(r, i * 2); });
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(items.load(), 8);
+}
+
+void t1()
+{
+    // Partial batches are flushed when the window expires.
+    std::atomic<int> calls{0};
+    std::atomic<int> items{0};
+
+    batcher b{in<int>, 100, 5ms, doubling(calls, items)};
+
+    thread_pool p{2};
+    for(int i = 0; i < 10; ++i)
+    {
+        auto graph = seq{seq{leaf{[i] { return i; }}, b.ref()},
+            leaf{[](int x) { return x + 1; }}};
+
+        sync_execute(p, graph, [i](int r) { EXPECT_EQ(r, i * 2 + 1); });
+    }
+
+    EXPECT_EQ(calls.load(), 10);
+    EXPECT_EQ(items.load(), 10);
+}
+
+void t2()
+{
+    // Many executions racing on several shards all get their own result.
+    std::atomic<int> calls{0};
+    std::atomic<int> items{0};
+
+    batcher b{in<int>, 16, 1ms, doubling(calls, items), 4};
+
+    {
+        thread_pool p{4};
+        std::vector<std::thread> ts;
+
+        for(int t = 0; t < 4; ++t)
+        {
+            ts.emplace_back([&b, &p, t] {
+                auto graph = seq{leaf{[t] { return t; }}, b.ref()};
+                for(int i = 0; i < 50; ++i)
+                {
+                    sync_execute(p, graph, [t](int r) { EXPECT_EQ(r, t * 2); });
+                }
+            });
+        }
+
+        for(auto& t : ts)
+        {
+            t.join();
+        }
+    }
+
+    EXPECT_EQ(items.load(), 200);
+}
+
+void t3()
+{
+    // Batches flushed by the timer resume executions driven by an event
+    // loop.
+    std::atomic<int> calls{0};
+    std::atomic<int> items{0};
+
+    batcher b{in<int>, 100, 10ms, doubling(calls, items)};
+    event_loop l;
+
+    for(int i = 0; i < 5; ++i)
+    {
+        auto graph = seq{seq{leaf{[i] { return i; }}, b.ref()},
+            all{leaf{[](int x) { return x + 1; }},
+                leaf{[](int x) { return x + 2; }}}};
+
+        sync_execute(l, graph, [i](auto r) {
+            EXPECT_EQ(get<0>(r), i * 2 + 1);
+            EXPECT_EQ(get<1>(r), i * 2 + 2);
+        });
+    }
+
+    EXPECT_EQ(calls.load(), 5);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <orizzonte/node.hpp>
+#include <orizzonte/utility.hpp>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::utility::sync_execute;
+
+// Records single and bulk submissions. Bulk submissions are executed on a
+// separate thread per index, in reverse order.
+struct bulk_scheduler
+{
+    int _single{0};
+    std::vector<std::size_t> _bulk;
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        ++_single;
+        std::thread{std::move(f)}.detach();
+    }
+
+    template <typename F>
+    void bulk(std::size_t n, F&& f)
+    {
+        _bulk.push_back(n);
+        for(std::size_t i = n; i-- > 0;)
+        {
+            std::thread{[f, i]() mutable { f(i); }}.detach();
+        }
+    }
+};
+
+void t0()
+{
+    bulk_scheduler s;
+
+    auto graph = all{
+        leaf{[] { return 0; }}, //
+        leaf{[] { return 1; }}, //
+        leaf{[] { return 2; }}, //
+        leaf{[] { return 3; }}  //
+    };
+
+    sync_execute(s, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 0);
+        EXPECT_EQ(get<1>(r), 1);
+        EXPECT_EQ(get<2>(r), 2);
+        EXPECT_EQ(get<3>(r), 3);
+    });
+
+    // The last child is executed inline.
+    EXPECT_EQ(s._single, 0);
+    EXPECT(s._bulk == (std::vector<std::size_t>{3}));
+}
+
+void t1()
+{
+    bulk_scheduler s;
+
+    // Trivial children are not part of the batch.
+    auto graph = all{
+        leaf{cost<trivial>, [] { return 0; }}, //
+        leaf{cost<heavy>, [] { return 1; }},   //
+        leaf{[] { return 2; }},                //
+        leaf{[] { return 3; }},                //
+        leaf{cost<trivial>, [] { return 4; }}  //
+    };
+
+    sync_execute(s, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 0);
+        EXPECT_EQ(get<1>(r), 1);
+        EXPECT_EQ(get<4>(r), 4);
+    });
+
+    EXPECT_EQ(s._single, 0);
+    EXPECT(s._bulk == (std::vector<std::size_t>{2}));
+}
+
+void t2()
+{
+    bulk_scheduler s;
+
+    // A single scheduled child does not need a batch.
+    auto graph = any{
+        leaf{[] { return 0; }}, //
+        leaf{[] { return 0; }}  //
+    };
+
+    sync_execute(s, graph, [](auto r) { EXPECT_EQ(get<int>(r), 0); });
+
+    EXPECT_EQ(s._single, 1);
+    EXPECT(s._bulk.empty());
+}
+
+void t3()
+{
+    bulk_scheduler s;
+
+    auto graph = any{
+        leaf{[] { return 0; }}, //
+        leaf{[] { return 0; }}, //
+        leaf{[] { return 0; }}  //
+    };
+
+    sync_execute(s, graph, [](auto r) { EXPECT_EQ(get<int>(r), 0); });
+
+    EXPECT_EQ(s._single, 0);
+    EXPECT(s._bulk == (std::vector<std::size_t>{2}));
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
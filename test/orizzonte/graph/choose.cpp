@@ -0,0 +1,135 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <string>
+#include <thread>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+// Counts the computations submitted to it.
+struct counting_scheduler
+{
+    int _scheduled{0};
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        ++_scheduled;
+        f();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+void t0()
+{
+    // Only the selected child is executed, with the incoming value.
+    std::atomic<int> executed[3]{};
+
+    auto graph = seq{leaf{[] { return 2; }},
+        choose{[](int x) { return x; },
+            leaf{[&executed](int x) { ++executed[0]; return x; }},
+            leaf{[&executed](int x) { ++executed[1]; return x * 10; }},
+            leaf{[&executed](int x) { ++executed[2]; return x * 100; }}}};
+
+    static_assert(std::is_same_v<decltype(graph)::out_type, int>);
+
+    sync_execute(S{}, graph, [](int r) { EXPECT_EQ(r, 200); });
+    EXPECT_EQ(executed[0].load(), 0);
+    EXPECT_EQ(executed[1].load(), 0);
+    EXPECT_EQ(executed[2].load(), 1);
+}
+
+void t1()
+{
+    // Different output types are unified in a variant.
+    auto graph = seq{leaf{[] { return 1; }},
+        choose{[](int x) { return x == 1; },
+            leaf{[](int x) { return x; }},
+            leaf{[](int) { return std::string{"one"}; }}}};
+
+    counting_scheduler s;
+    sync_execute(s, graph, [](const auto& r) {
+        EXPECT_EQ(r.which(), 1);
+        EXPECT_EQ(get<1>(r), "one");
+    });
+
+    // Nothing was scheduled.
+    EXPECT_EQ(s._scheduled, 0);
+}
+
+void t2()
+{
+    // Selectors without input, and parallel children.
+    bool left = false;
+
+    auto graph = choose{[&left] { return left ? 0 : 1; },
+        all{leaf{[] { return 1; }}, leaf{[] { return 2; }}},
+        all{leaf{[] { return 3; }}, leaf{[] { return 4; }}}};
+
+    thread_pool p{4};
+    for(int i = 0; i < 20; ++i)
+    {
+        left = i % 2 == 0;
+        sync_execute(p, graph, [i](auto r) {
+            EXPECT_EQ(get<0>(r), i % 2 == 0 ? 1 : 3);
+            EXPECT_EQ(get<1>(r), i % 2 == 0 ? 2 : 4);
+        });
+    }
+}
+
+void t3()
+{
+    // Cleanups of the children that are not taken are still invoked.
+    auto graph = choose{[] { return 1; },
+        any{leaf{[] { return 1; }}, leaf{[] { return 2; }}},
+        leaf{[] { return 3; }}};
+
+    static_assert(decltype(graph)::cleanup_count() == 1);
+
+    thread_pool p{4};
+    for(int i = 0; i < 20; ++i)
+    {
+        sync_execute(p, graph, [](const auto& r) { EXPECT_EQ(r.which(), 1); });
+    }
+}
+
+void t4()
+{
+    // Out-of-range indices, including negative ones, select the last child.
+    int index = 0;
+
+    auto graph = choose{[&index] { return index; },
+        leaf{[] { return 0; }}, leaf{[] { return 1; }}};
+
+    for(int x : {0, 1, 2, 100, -1})
+    {
+        index = x;
+        sync_execute(S{}, graph, [x](int r) { EXPECT_EQ(r, x == 0 ? 0 : 1); });
+    }
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+}
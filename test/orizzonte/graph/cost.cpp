@@ -0,0 +1,135 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <orizzonte/node.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+#include <vector>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+// Records whether computations were scheduled, and runs them synchronously.
+struct recording_scheduler
+{
+    int _scheduled{0};
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        ++_scheduled;
+        f();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::utility::sync_execute;
+
+auto f_trivial = [] { return 0; };
+auto f_normal = [] { return 1; };
+using l_trivial = decltype(leaf{cost<trivial>, std::move(f_trivial)});
+using l_light = decltype(leaf{cost<light>, std::move(f_normal)});
+using l_normal = decltype(leaf{std::move(f_normal)});
+using l_heavy = decltype(leaf{cost<heavy>, std::move(f_normal)});
+
+static_assert(l_trivial::cost() == trivial);
+static_assert(l_normal::cost() == normal);
+static_assert(l_heavy::cost() == heavy);
+static_assert(seq<l_heavy, l_light>::cost() == heavy + light);
+static_assert(all<l_heavy, l_light>::cost() == heavy);
+static_assert(any<l_light, l_normal>::cost() == normal);
+
+template <typename... Xs>
+using plan = detail::execution_plan<Xs...>;
+
+template <typename Plan, typename... Is>
+constexpr bool order_is(Is... is)
+{
+    std::size_t expected[]{std::size_t(is)...};
+    for(std::size_t i = 0; i < sizeof...(is); ++i)
+    {
+        if(Plan::order[i] != expected[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Equal costs: same behavior as before, the last child is executed inline.
+static_assert(plan<l_normal, l_normal, l_normal>::inline_index == 2);
+static_assert(order_is<plan<l_normal, l_normal, l_normal>>(0, 1, 2));
+
+// The most expensive child is executed inline, heavier children are
+// submitted first.
+static_assert(plan<l_light, l_heavy, l_normal>::inline_index == 1);
+static_assert(order_is<plan<l_light, l_heavy, l_normal>>(2, 0, 1));
+
+static_assert(order_is<plan<l_light, l_normal, l_heavy, l_normal, l_heavy>>(
+    2, 1, 3, 0, 4));
+
+// Trivial children are executed inline, after every scheduled child.
+static_assert(
+    order_is<plan<l_trivial, l_normal, l_trivial, l_heavy>>(1, 0, 2, 3));
+static_assert(plan<l_trivial, l_normal, l_trivial, l_heavy>::runs_inline(0));
+static_assert(!plan<l_trivial, l_normal, l_trivial, l_heavy>::runs_inline(1));
+static_assert(order_is<plan<l_trivial, l_trivial>>(0, 1));
+
+void t0()
+{
+    auto graph = all{
+        leaf{cost<light>, [] { return 0; }}, //
+        leaf{cost<heavy>, [] { return 1; }}, //
+        leaf{[] { return 2; }}               //
+    };
+
+    sync_execute(S{}, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 0);
+        EXPECT_EQ(get<1>(r), 1);
+        EXPECT_EQ(get<2>(r), 2);
+    });
+}
+
+void t1()
+{
+    std::vector<int> started;
+
+    auto graph = all{
+        leaf{cost<light>, [&started] { started.push_back(0); }},   //
+        leaf{cost<heavy>, [&started] { started.push_back(1); }},   //
+        leaf{cost<trivial>, [&started] { started.push_back(2); }}, //
+        leaf{[&started] { started.push_back(3); }}                 //
+    };
+
+    recording_scheduler s;
+    sync_execute(s, graph, [](auto&&) {});
+
+    EXPECT_EQ(s._scheduled, 2);
+    EXPECT(started == (std::vector<int>{3, 0, 2, 1}));
+}
+
+void t2()
+{
+    auto graph = leaf{in<int>, cost<heavy>, [](int x) { return x + 1; }};
+    static_assert(decltype(graph)::cost() == heavy);
+
+    auto root = leaf{[] { return 41; }}.then(std::move(graph));
+    sync_execute(S{}, root, [](int r) { EXPECT_EQ(r, 42); });
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+}
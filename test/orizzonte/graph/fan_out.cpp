@@ -0,0 +1,161 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::chunked_file;
+using orizzonte::utility::sync_execute;
+
+std::vector<int> iota(int n)
+{
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+auto count_lines = [](std::string_view chunk) {
+    return std::size_t(std::count(chunk.begin(), chunk.end(), '\n'));
+};
+
+template <typename Scheduler>
+void squares(Scheduler&& s, int n)
+{
+    auto graph = seq{leaf{[n] { return iota(n); }},
+        fan_out{in<std::vector<int>>, [](int x) { return x * x; }}};
+
+    sync_execute(s, graph, [n](std::vector<int> r) {
+        EXPECT_EQ(r.size(), static_cast<std::size_t>(n));
+        for(int i = 0; i < n; ++i)
+        {
+            EXPECT_EQ(r[i], i * i);
+        }
+    });
+}
+
+void t0()
+{
+    for(int n : {0, 1, 2, 100})
+    {
+        squares(S{}, n);
+        squares(inline_scheduler{}, n);
+    }
+
+    thread_pool p{4};
+    for(int i = 0; i < 100; ++i)
+    {
+        squares(p, 64);
+    }
+}
+
+void t1()
+{
+    // `void` results are represented as `nothing`.
+    std::atomic<int> acc{0};
+    auto graph = seq{leaf{[] { return iota(10); }},
+        fan_out{in<std::vector<int>>, [&acc](int x) { acc += x; }}};
+
+    thread_pool p{4};
+    sync_execute(p, graph, [](auto r) { EXPECT_EQ(r.size(), 10u); });
+    EXPECT_EQ(acc.load(), 45);
+}
+
+void t2()
+{
+    // Line count of a file, one chunk per element.
+    std::string contents;
+    for(int i = 0; i < 5000; ++i)
+    {
+        contents += "line " + std::to_string(i) + '\n';
+    }
+
+    char path[] = "/tmp/orizzonte_fan_out_XXXXXX";
+    const int fd = ::mkstemp(path);
+    const auto written = ::write(fd, contents.data(), contents.size());
+    EXPECT(written == ssize_t(contents.size()));
+    ::close(fd);
+
+    auto graph = seq{file_chunks(path, 4096),
+        seq{fan_out{in<chunked_file>, std::move(count_lines)},
+            leaf{[](std::vector<std::size_t> counts) {
+                return std::accumulate(
+                    counts.begin(), counts.end(), std::size_t(0));
+            }}}};
+
+    thread_pool p{4};
+    sync_execute(p, graph, [](std::size_t r) { EXPECT_EQ(r, 5000u); });
+    sync_execute(S{}, graph, [](std::size_t r) { EXPECT_EQ(r, 5000u); });
+
+    ::unlink(path);
+}
+
+void t3()
+{
+    // Boolean results are written concurrently.
+    auto graph = seq{leaf{[] { return iota(1000); }},
+        fan_out{in<std::vector<int>>, [](int x) { return x % 3 == 0; }}};
+
+    thread_pool p{4};
+    for(int i = 0; i < 20; ++i)
+    {
+        sync_execute(p, graph, [](std::vector<bool> r) {
+            EXPECT_EQ(r.size(), 1000u);
+            for(std::size_t j = 0; j < r.size(); ++j)
+            {
+                EXPECT_EQ(r[j], j % 3 == 0);
+            }
+        });
+    }
+}
+
+void t4()
+{
+    // Results can refer to the input until the continuation returns.
+    auto graph = seq{leaf{[] {
+                         return std::vector<std::string>{
+                             std::string(100, 'a'), "b", "cc"};
+                     }},
+        seq{fan_out{in<std::vector<std::string>>,
+                [](const std::string& x) { return std::string_view{x}; }},
+            leaf{[](std::vector<std::string_view> r) {
+                return std::string{r[0]} + std::string{r[1]} +
+                       std::string{r[2]};
+            }}}};
+
+    thread_pool p{2};
+    sync_execute(p, graph, [](std::string r) {
+        EXPECT(r == std::string(100, 'a') + "bcc");
+    });
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <string>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+void t0()
+{
+    // Only stages whose input changed are executed again.
+    int inputs[2] = {1, 2};
+    int calls[2] = {0, 0};
+
+    auto stage = [&](int i) {
+        return seq{leaf{[&inputs, i] { return inputs[i]; }},
+            incremental{leaf{[&calls, i](int x) {
+                ++calls[i];
+                return std::to_string(x);
+            }}}};
+    };
+
+    auto graph = all{stage(0), stage(1)};
+
+    auto run = [&](const char* a, const char* b) {
+        sync_execute(inline_scheduler{}, graph, [&](auto r) {
+            EXPECT_EQ(get<0>(r), a);
+            EXPECT_EQ(get<1>(r), b);
+        });
+    };
+
+    run("1", "2");
+    run("1", "2");
+    EXPECT_EQ(calls[0], 1);
+    EXPECT_EQ(calls[1], 1);
+
+    inputs[1] = 5;
+    run("1", "5");
+    EXPECT_EQ(calls[0], 1);
+    EXPECT_EQ(calls[1], 2);
+}
+
+void t1()
+{
+    // Sources are keyed by a version, and can be invalidated.
+    int version = 0;
+    int calls = 0;
+
+    auto source = incremental{[&version] { return version; },
+        leaf{[&calls] { return ++calls; }}};
+
+    thread_pool p{2};
+    auto graph = seq{std::move(source), leaf{[](int x) { return x * 10; }}};
+
+    sync_execute(p, graph, [](int r) { EXPECT_EQ(r, 10); });
+    sync_execute(p, graph, [](int r) { EXPECT_EQ(r, 10); });
+    EXPECT_EQ(calls, 1);
+
+    ++version;
+    sync_execute(p, graph, [](int r) { EXPECT_EQ(r, 20); });
+    EXPECT_EQ(calls, 2);
+}
+
+void t2()
+{
+    // Nodes without input nor key are always executed.
+    int calls = 0;
+    auto graph = incremental{leaf{[&calls] { return ++calls; }}};
+
+    sync_execute(inline_scheduler{}, graph, [](int) {});
+    sync_execute(inline_scheduler{}, graph, [](int) {});
+    EXPECT_EQ(calls, 2);
+
+    // Invalidation forces a re-execution.
+    int keyed_calls = 0;
+    auto keyed = incremental{
+        [] { return 0; }, leaf{[&keyed_calls] { return ++keyed_calls; }}};
+
+    sync_execute(inline_scheduler{}, keyed, [](int r) { EXPECT_EQ(r, 1); });
+    sync_execute(inline_scheduler{}, keyed, [](int r) { EXPECT_EQ(r, 1); });
+
+    keyed.invalidate();
+    sync_execute(inline_scheduler{}, keyed, [](int r) { EXPECT_EQ(r, 2); });
+}
+
+void t3()
+{
+    // Copies and moves carry the cache over.
+    int calls = 0;
+    auto graph = seq{leaf{[] { return 4; }}, incremental{leaf{[&calls](int x) {
+                                                 ++calls;
+                                                 return x * 2;
+                                             }}}};
+
+    sync_execute(inline_scheduler{}, graph, [](int r) { EXPECT_EQ(r, 8); });
+
+    auto copy = graph;
+    sync_execute(inline_scheduler{}, copy, [](int r) { EXPECT_EQ(r, 8); });
+    EXPECT_EQ(calls, 1);
+
+    auto moved = std::move(copy);
+    sync_execute(inline_scheduler{}, moved, [](int r) { EXPECT_EQ(r, 8); });
+    EXPECT_EQ(calls, 1);
+
+    sync_execute(inline_scheduler{}, graph, [](int r) { EXPECT_EQ(r, 8); });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
@@ -0,0 +1,181 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::event_loop;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::async_semaphore;
+using orizzonte::utility::sync_execute;
+
+void t0()
+{
+    // Inline executions never wait and give their permit back.
+    async_semaphore sem{1};
+
+    auto graph = seq{leaf{[] { return 2; }},
+        limit{sem, leaf{[](int x) { return x * 5; }}}};
+
+    for(int i = 0; i < 3; ++i)
+    {
+        sync_execute(
+            inline_scheduler{}, graph, [](int r) { EXPECT_EQ(r, 10); });
+    }
+
+    EXPECT_EQ(sem.available(), 1u);
+    EXPECT_EQ(sem.waiting(), 0u);
+}
+
+void t1()
+{
+    // Concurrent executions never exceed the limit, and all complete.
+    async_semaphore sem{2};
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> done{0};
+
+    thread_pool p{4};
+    std::vector<std::thread> ts;
+
+    for(int t = 0; t < 6; ++t)
+    {
+        ts.emplace_back([&, t] {
+            for(int i = 0; i < 50; ++i)
+            {
+                auto graph = seq{leaf{[i] { return i; }},
+                    limit{sem, leaf{[&](int x) {
+                        const int now = ++running;
+                        int prev = peak.load();
+                        while(now > prev && !peak.compare_exchange_weak(prev, now))
+                        {
+                        }
+
+                        std::this_thread::yield();
+                        --running;
+                        return x + t;
+                    }}}};
+
+                sync_execute(p, graph, [&, i, t](int r) {
+                    EXPECT_EQ(r, i + t);
+                    ++done;
+                });
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(done.load(), 300);
+    EXPECT(peak.load() <= 2);
+    EXPECT_EQ(sem.available(), 2u);
+}
+
+void t2()
+{
+    // A waiting execution resumes once the permit holder completed,
+    // including its cleanups.
+    async_semaphore sem{1};
+    std::atomic<bool> release{false};
+    std::atomic<bool> second_ran{false};
+
+    thread_pool p{2};
+
+    std::thread first{[&] {
+        auto graph = limit{sem, any{leaf{[&] {
+                                        while(!release)
+                                        {
+                                            std::this_thread::yield();
+                                        }
+
+                                        return 1;
+                                    }},
+                                    leaf{[] { return 2; }}}};
+
+        sync_execute(p, graph, [](auto&&) {});
+    }};
+
+    while(sem.available() != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    std::thread second{[&] {
+        auto graph = limit{sem, leaf{[&] {
+            second_ran = true;
+            return 3;
+        }}};
+
+        sync_execute(p, graph, [](int r) { EXPECT_EQ(r, 3); });
+    }};
+
+    while(sem.waiting() != 1)
+    {
+        std::this_thread::yield();
+    }
+
+    EXPECT_FALSE(second_ran.load());
+    release = true;
+
+    first.join();
+    second.join();
+
+    EXPECT_TRUE(second_ran.load());
+    EXPECT_EQ(sem.available(), 1u);
+}
+
+void t3()
+{
+    // A permit handed over by another thread resumes an execution driven
+    // by an event loop.
+    async_semaphore sem{1};
+    thread_pool p{1};
+
+    std::thread holder{[&] {
+        auto graph = limit{sem, leaf{[] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            return 1;
+        }}};
+
+        sync_execute(p, graph, [](int r) { EXPECT_EQ(r, 1); });
+    }};
+
+    while(sem.available() != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    event_loop l;
+    auto graph = seq{limit{sem, leaf{[] { return 3; }}},
+        all{leaf{[](int x) { return x + 1; }},
+            leaf{[](int x) { return x + 2; }}}};
+
+    sync_execute(l, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 4);
+        EXPECT_EQ(get<1>(r), 5);
+    });
+
+    holder.join();
+    EXPECT_EQ(sem.available(), 1u);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
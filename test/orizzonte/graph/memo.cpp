@@ -0,0 +1,74 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <string>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::clock_eviction;
+using orizzonte::utility::concurrent_cache;
+using orizzonte::utility::sync_execute;
+
+void t0()
+{
+    // Hits skip the leaf.
+    int calls = 0;
+    concurrent_cache<int, std::string> cache{1024};
+
+    for(int i = 0; i < 10; ++i)
+    {
+        auto graph = seq{leaf{[i] { return i % 2; }},
+            memo{cache, leaf{[&calls](int x) {
+                     ++calls;
+                     return std::to_string(x);
+                 }}}};
+
+        sync_execute(inline_scheduler{}, graph,
+            [i](const std::string& r) { EXPECT_EQ(r, std::to_string(i % 2)); });
+    }
+
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(cache.hits(), 8u);
+    EXPECT_EQ(cache.misses(), 2u);
+}
+
+void t1()
+{
+    // A cache can be shared by parallel nodes.
+    std::atomic<int> calls{0};
+    concurrent_cache<int, int, clock_eviction> cache{1024};
+
+    auto square = [&] {
+        return memo{cache, leaf{[&calls](int x) {
+                        ++calls;
+                        return x * x;
+                    }}};
+    };
+
+    auto graph = seq{leaf{[] { return 3; }}, all{square(), square()}};
+
+    thread_pool p{4};
+    for(int i = 0; i < 20; ++i)
+    {
+        sync_execute(p, graph, [](auto r) {
+            EXPECT_EQ(get<0>(r), 9);
+            EXPECT_EQ(get<1>(r), 9);
+        });
+    }
+
+    EXPECT(calls.load() <= 2);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+}
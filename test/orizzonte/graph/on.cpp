@@ -0,0 +1,159 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::event_loop;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+thread_local int current_tag = 0;
+
+// Thread-per-task scheduler tagging its threads, and counting submissions.
+struct tagged
+{
+    int _tag;
+    std::atomic<int> _submitted{0};
+
+    explicit tagged(int tag) : _tag{tag}
+    {
+    }
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        ++_submitted;
+        std::thread{[tag = _tag, g = std::move(f)]() mutable {
+            current_tag = tag;
+            g();
+        }}
+            .detach();
+    }
+};
+
+void t0()
+{
+    // The subgraph runs on the target, and the continuation comes back to
+    // the parent scheduler, with one submission in each direction.
+    tagged compute{1};
+    tagged io{2};
+
+    auto graph = seq{seq{leaf{[] { return 1; }}, on{io, leaf{[](int x) {
+                                                       EXPECT_EQ(current_tag, 2);
+                                                       return x + 1;
+                                                   }}}},
+        leaf{[](int x) {
+            EXPECT_EQ(current_tag, 1);
+            return x * 10;
+        }}};
+
+    sync_execute(compute, graph, [](int r) { EXPECT_EQ(r, 20); });
+
+    EXPECT_EQ(compute._submitted.load(), 1);
+    EXPECT_EQ(io._submitted.load(), 1);
+}
+
+void t1()
+{
+    // Computations submitted by the subgraph go to the target.
+    tagged compute{1};
+    tagged io{2};
+
+    const auto check = [] {
+        return [] {
+            EXPECT_EQ(current_tag, 2);
+            return current_tag;
+        };
+    };
+
+    auto graph = on{io, all{leaf{check()}, leaf{check()}, leaf{check()}}};
+
+    sync_execute(compute, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 2);
+        EXPECT_EQ(get<2>(r), 2);
+    });
+
+    EXPECT_EQ(compute._submitted.load(), 1);
+    EXPECT(io._submitted.load() > 1);
+}
+
+void t2()
+{
+    // The cleanups of the subgraph are awaited before coming back.
+    tagged compute{1};
+    tagged io{2};
+
+    auto sub = on{io, any{leaf{[] { return 1; }}, leaf{[] { return 1; }}}};
+    using sub_out = decltype(sub)::out_type;
+
+    auto graph = seq{std::move(sub), leaf{in<sub_out>, [](sub_out) {
+                                              EXPECT_EQ(current_tag, 1);
+                                              return 5;
+                                          }}};
+
+    static_assert(decltype(graph)::cleanup_count() == 0);
+    sync_execute(compute, graph, [](int r) { EXPECT_EQ(r, 5); });
+}
+
+void t3()
+{
+    // Repeated round trips between two pools, and from an inline scheduler.
+    thread_pool compute{2};
+    thread_pool io{2};
+
+    auto graph = seq{leaf{[] { return 3; }},
+        on{io, seq{leaf{[](int x) { return x + 1; }},
+                   leaf{[](int x) { return x * 2; }}}}};
+
+    for(int i = 0; i < 100; ++i)
+    {
+        sync_execute(compute, graph, [](int r) { EXPECT_EQ(r, 8); });
+    }
+
+    for(int i = 0; i < 10; ++i)
+    {
+        sync_execute(inline_scheduler{}, graph, [](int r) { EXPECT_EQ(r, 8); });
+    }
+}
+
+void t4()
+{
+    // Blocking work hops off an event loop and back onto it.
+    event_loop loop;
+    thread_pool blocking{2};
+
+    auto graph = seq{on{blocking, leaf{[] {
+                                     std::this_thread::sleep_for(
+                                         std::chrono::milliseconds(100));
+                                     return 7;
+                                 }}},
+        all{leaf{[](int x) { return x + 1; }},
+            leaf{[](int x) { return x * 2; }}}};
+
+    for(int i = 0; i < 3; ++i)
+    {
+        sync_execute(loop, graph, [](auto r) {
+            EXPECT_EQ(get<0>(r), 8);
+            EXPECT_EQ(get<1>(r), 14);
+        });
+    }
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+}
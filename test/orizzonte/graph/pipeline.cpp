@@ -0,0 +1,160 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+std::vector<int> iota(int n)
+{
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+template <typename Scheduler>
+void serial_order(Scheduler&& s, int n)
+{
+    // Serial stages preserve the order of the input.
+    std::vector<std::string> out;
+
+    auto graph = seq{leaf{[n] { return iota(n); }},
+        pipeline{in<std::vector<int>>, 4,
+            serial([](int x) { return x * 2; }),
+            serial([](int x) { return std::to_string(x); }),
+            serial([&out](std::string x) { out.push_back(std::move(x)); })}};
+
+    sync_execute(s, graph, [] {});
+
+    EXPECT_EQ(out.size(), static_cast<std::size_t>(n));
+    for(int i = 0; i < n; ++i)
+    {
+        EXPECT(out[i] == std::to_string(i * 2));
+    }
+}
+
+template <typename Scheduler>
+void parallel_sum(Scheduler&& s, int n)
+{
+    std::atomic<int> count{0};
+    long long sum = 0;
+
+    auto graph = seq{leaf{[n] { return iota(n); }},
+        pipeline{in<std::vector<int>>, 8,
+            parallel([&count](int x) {
+                ++count;
+                return x + 1;
+            }),
+            parallel([](int x) { return static_cast<long long>(x) * x; }),
+            serial([&sum](long long x) { sum += x; })}};
+
+    sync_execute(s, graph, [] {});
+
+    long long expected = 0;
+    for(long long i = 1; i <= n; ++i)
+    {
+        expected += i * i;
+    }
+
+    EXPECT_EQ(count.load(), n);
+    EXPECT_EQ(sum, expected);
+}
+
+void t0()
+{
+    for(int n : {0, 1, 2, 100})
+    {
+        serial_order(S{}, n);
+        serial_order(inline_scheduler{}, n);
+        parallel_sum(S{}, n);
+        parallel_sum(inline_scheduler{}, n);
+    }
+
+    thread_pool p{4};
+    for(int i = 0; i < 20; ++i)
+    {
+        serial_order(p, 500);
+        parallel_sum(p, 500);
+    }
+}
+
+void t1()
+{
+    // `void` stages forward `nothing`.
+    std::atomic<int> calls{0};
+
+    auto graph = seq{leaf{[] { return iota(50); }},
+        pipeline{in<std::vector<int>>, 2,
+            parallel([&calls](int) { ++calls; }),
+            serial([&calls] { ++calls; })}};
+
+    thread_pool p{4};
+    sync_execute(p, graph, [] {});
+    EXPECT_EQ(calls.load(), 100);
+}
+
+void t2()
+{
+    // A slow last stage bounds the number of items in flight.
+    constexpr std::size_t capacity = 4;
+    std::atomic<int> entered{0};
+    std::atomic<int> left{0};
+    std::atomic<int> max_in_flight{0};
+
+    auto graph = seq{leaf{[] { return iota(500); }},
+        pipeline{in<std::vector<int>>, capacity,
+            serial([&](int x) {
+                const int n = ++entered - left;
+                int m = max_in_flight.load();
+                while(n > m && !max_in_flight.compare_exchange_weak(m, n))
+                {
+                }
+
+                return x;
+            }),
+            parallel([](int x) { return x; }),
+            serial([&](int) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                ++left;
+            })}};
+
+    thread_pool p{4};
+    sync_execute(p, graph, [] {});
+
+    EXPECT_EQ(left.load(), 500);
+
+    // Every link holds at most `capacity` items, and the last stage processes
+    // one item at a time.
+    EXPECT(max_in_flight.load() <= int(3 * capacity + 1));
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+#include <vector>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+template <typename Scheduler>
+void count_up(Scheduler&& s)
+{
+    auto graph = seq{leaf{[] { return 0; }},
+        repeat_until{leaf{[](int x) { return x + 1; }},
+            [](int x) { return x == 100000; }}};
+
+    // Executing the graph again starts from a clean state.
+    for(int i = 0; i < 3; ++i)
+    {
+        sync_execute(s, graph, [](int r) { EXPECT_EQ(r, 100000); });
+    }
+}
+
+void t0()
+{
+    // Long inline loops do not overflow the stack.
+    count_up(inline_scheduler{});
+    count_up(S{});
+
+    thread_pool p{4};
+    count_up(p);
+}
+
+void t1()
+{
+    // The body is executed at least once, and receives its own output.
+    int executed = 0;
+
+    auto graph = seq{leaf{[] { return std::vector<int>{}; }},
+        repeat_until{leaf{[&executed](std::vector<int> v) {
+                         ++executed;
+                         v.push_back(executed);
+                         return v;
+                     }},
+            [](const std::vector<int>& v) { return !v.empty(); }}};
+
+    sync_execute(S{}, graph, [](const std::vector<int>& r) {
+        EXPECT_EQ(r.size(), 1u);
+        EXPECT_EQ(r[0], 1);
+    });
+
+    EXPECT_EQ(executed, 1);
+}
+
+void t2()
+{
+    // Parallel bodies, whose cleanups are absorbed by the loop.
+    auto body = seq{
+        any{leaf{[](int x) { return x + 1; }},
+            leaf{[](int x) { return x + 1; }}},
+        leaf{[](const orizzonte::variant<int, int>& v) {
+            return v.which() == 0 ? get<0>(v) : get<1>(v);
+        }}};
+
+    auto graph = seq{leaf{[] { return 0; }},
+        repeat_until{std::move(body), [](int x) { return x == 200; }}};
+
+    static_assert(decltype(graph)::cleanup_count() == 0);
+
+    thread_pool p{4};
+    for(int i = 0; i < 10; ++i)
+    {
+        sync_execute(p, graph, [](int r) { EXPECT_EQ(r, 200); });
+    }
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <numeric>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+/*
+              /--> (sum)  --\
+    (values) -               --> all
+              \--> (size) --/
+*/
+template <typename Scheduler>
+void diamond(Scheduler&& s)
+{
+    std::atomic<int> computed{0};
+
+    auto values = shared{leaf{[&computed] {
+        ++computed;
+        std::vector<int> result(100);
+        std::iota(result.begin(), result.end(), 0);
+        return result;
+    }}};
+
+    auto graph = all{
+        seq{values.ref(), leaf{[](const std::vector<int>& v) {
+                return std::accumulate(v.begin(), v.end(), 0);
+            }}},
+        seq{values.ref(),
+            leaf{[](const std::vector<int>& v) { return v.size(); }}},
+        seq{values.ref(),
+            leaf{[](const std::vector<int>& v) { return v.data(); }}},
+        seq{values.ref(),
+            leaf{[](const std::vector<int>& v) { return v.data(); }}}};
+
+    for(int i = 1; i <= 20; ++i)
+    {
+        sync_execute(s, graph, [](auto r) {
+            EXPECT_EQ(get<0>(r), 4950);
+            EXPECT_EQ(get<1>(r), 100u);
+
+            // Consumers receive the same object.
+            EXPECT_EQ(get<2>(r), get<3>(r));
+        });
+
+        EXPECT_EQ(computed.load(), i);
+    }
+}
+
+void t0()
+{
+    diamond(S{});
+    diamond(inline_scheduler{});
+
+    thread_pool p{4};
+    diamond(p);
+}
+
+void t1()
+{
+    // Consumers waiting for an asynchronous shared subgraph are resumed.
+    auto answer = shared{async_leaf{out<int>, [](auto done) {
+        std::thread{[done = std::move(done)]() mutable { done(42); }}
+            .detach();
+    }}};
+
+    auto graph = all{seq{answer.ref(), leaf{[](int x) { return x + 1; }}},
+        seq{answer.ref(), leaf{[](int x) { return x + 2; }}},
+        seq{answer.ref(), leaf{[](int x) { return x + 3; }}}};
+
+    thread_pool p{4};
+    for(int i = 0; i < 50; ++i)
+    {
+        sync_execute(p, graph, [](auto r) {
+            EXPECT_EQ(get<0>(r), 43);
+            EXPECT_EQ(get<1>(r), 44);
+            EXPECT_EQ(get<2>(r), 45);
+        });
+    }
+}
+
+void t2()
+{
+    // Cleanups of a shared subgraph are accounted for by every consumer.
+    auto first = shared{any{leaf{[] { return 1; }}, leaf{[] { return 1; }}}};
+    static_assert(decltype(first.ref())::cleanup_count() == 1);
+
+    // Consumers are registered by `ref()` only.
+    using ref_type = decltype(first.ref());
+    static_assert(!std::is_copy_constructible_v<ref_type>);
+    static_assert(std::is_move_constructible_v<ref_type>);
+
+    auto graph = all{first.ref(), first.ref()};
+
+    thread_pool p{4};
+    for(int i = 0; i < 50; ++i)
+    {
+        sync_execute(p, graph, [](auto r) {
+            EXPECT_EQ(get<0>(r).which(), 0);
+            EXPECT_EQ(get<1>(r).which(), 0);
+        });
+    }
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+}
@@ -0,0 +1,128 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+void t0()
+{
+    // Concurrent executions with the same key share one invocation.
+    std::atomic<int> calls{0};
+    std::atomic<bool> release{false};
+
+    single_flight f{in<int>, [](int x) { return x % 2; },
+        [&](int x) {
+            ++calls;
+            while(!release)
+            {
+                std::this_thread::yield();
+            }
+
+            return std::to_string(x % 2);
+        }};
+
+    std::atomic<int> started{0};
+    thread_pool p{2};
+    std::vector<std::thread> ts;
+
+    for(int i = 0; i < 8; ++i)
+    {
+        ts.emplace_back([&, i] {
+            auto graph = seq{leaf{[i] { return i; }}, f.ref()};
+            ++started;
+            sync_execute(p, graph, [i](const std::string& r) {
+                EXPECT_EQ(r, std::to_string(i % 2));
+            });
+        });
+    }
+
+    // Give every execution the time to join a flight.
+    while(started != 8)
+    {
+        std::this_thread::yield();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(calls.load(), 2);
+}
+
+void t1()
+{
+    // Sequential executions are not deduplicated.
+    int calls = 0;
+
+    single_flight f{in<int>, [](int x) { return x; },
+        [&calls](int x) {
+            ++calls;
+            return x * 3;
+        },
+        1};
+
+    for(int i = 0; i < 3; ++i)
+    {
+        auto graph = seq{leaf{[] { return 7; }}, f.ref()};
+        sync_execute(inline_scheduler{}, graph, [](int r) { EXPECT_EQ(r, 21); });
+    }
+
+    EXPECT_EQ(calls, 3);
+}
+
+void t2()
+{
+    // Racing executions on many keys always get the result of their key.
+    std::atomic<int> calls{0};
+
+    single_flight f{in<int>, [](int x) { return x; },
+        [&calls](int x) {
+            ++calls;
+            return x + 1;
+        }};
+
+    thread_pool p{4};
+    std::vector<std::thread> ts;
+
+    for(int t = 0; t < 4; ++t)
+    {
+        ts.emplace_back([&] {
+            for(int i = 0; i < 200; ++i)
+            {
+                auto graph = seq{leaf{[i] { return i % 5; }}, f.ref()};
+                sync_execute(p, graph, [i](int r) { EXPECT_EQ(r, i % 5 + 1); });
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    EXPECT(calls.load() <= 800);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+}
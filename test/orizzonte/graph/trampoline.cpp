@@ -0,0 +1,238 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <pthread.h>
+#include <thread>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::utility::sync_execute;
+
+thread_local int stages_left = 0;
+
+// Non-trivially destructible local of every stage: the inline call to the
+// next stage cannot be turned into a tail call, which would hide an
+// unbounded recursion when optimizing.
+struct stage_frame
+{
+    stage_frame() noexcept
+    {
+        ++stages_left;
+    }
+
+    ~stage_frame()
+    {
+        --stages_left;
+    }
+};
+
+struct chain;
+
+struct decrement
+{
+    int operator()(int x) const
+    {
+        return x - 1;
+    }
+};
+
+// Re-enters `chain` from `B`, so that a single `seq` node can be used to run
+// an arbitrary number of inline stages.
+struct chain_ref
+{
+    using in_type = int;
+    using out_type = int;
+
+    chain* _chain;
+
+    template <typename Scheduler, typename Input, typename Then,
+        typename Cleanup>
+    void execute(
+        Scheduler& scheduler, Input&& input, Then&& then, Cleanup&& cleanup) &;
+
+    static constexpr std::size_t cleanup_count() noexcept
+    {
+        return 0;
+    }
+};
+
+// Runtime-length chain of `seq` stages that all complete inline.
+struct chain
+{
+    using in_type = int;
+    using out_type = int;
+
+    int _stages;
+    seq<leaf<int, decrement>, chain_ref> _stage;
+
+    chain(int stages)
+        : _stages{stages}, _stage{leaf<int, decrement>{decrement{}},
+                               chain_ref{this}}
+    {
+    }
+
+    template <typename Scheduler, typename Input, typename Then,
+        typename Cleanup>
+    void execute(
+        Scheduler& scheduler, Input&& input, Then&& then, Cleanup&& cleanup) &
+    {
+        if(input == 0)
+        {
+            then(_stages);
+            return;
+        }
+
+        stage_frame f;
+        _stage.execute(scheduler, FWD(input), then, cleanup);
+    }
+
+    static constexpr std::size_t cleanup_count() noexcept
+    {
+        return 0;
+    }
+};
+
+template <typename Scheduler, typename Input, typename Then, typename Cleanup>
+void chain_ref::execute(
+    Scheduler& scheduler, Input&& input, Then&& then, Cleanup&& cleanup) &
+{
+    _chain->execute(scheduler, FWD(input), FWD(then), FWD(cleanup));
+}
+
+// Starts the chain from its number of stages.
+struct chain_root
+{
+    using in_type = orizzonte::utility::nothing;
+    using out_type = int;
+
+    chain _chain;
+
+    template <typename Scheduler, typename Input, typename Then,
+        typename Cleanup>
+    void execute(
+        Scheduler& scheduler, Input&&, Then&& then, Cleanup&& cleanup) &
+    {
+        _chain.execute(scheduler, _chain._stages, FWD(then), FWD(cleanup));
+    }
+
+    static constexpr std::size_t cleanup_count() noexcept
+    {
+        return 0;
+    }
+};
+
+template <typename F>
+void run_on_small_stack(F&& f)
+{
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 64 * 1024);
+
+    pthread_t t;
+    const auto rc = pthread_create(&t, &attr,
+        [](void* p) -> void* {
+            (*static_cast<F*>(p))();
+            return nullptr;
+        },
+        &f);
+
+    EXPECT_EQ(rc, 0);
+    pthread_join(t, nullptr);
+    pthread_attr_destroy(&attr);
+}
+
+void t0()
+{
+    // Short static chain, still correct across the trampoline boundary.
+    auto graph = leaf{[] { return 0; }}
+                     .then([](int x) { return x + 1; })
+                     .then([](int x) { return x + 1; })
+                     .then([](int x) { return x + 1; });
+
+    sync_execute(S{}, graph, [](int r) { EXPECT_EQ(r, 3); });
+}
+
+void t1()
+{
+    // 100k inline stages on a 64 KiB stack.
+    int result = 0;
+    run_on_small_stack([&result] {
+        chain_root graph{chain{100000}};
+        sync_execute(S{}, graph, [&result](int r) { result = r; });
+    });
+
+    EXPECT_EQ(result, 100000);
+}
+
+void t2()
+{
+    // Trampolining is per-thread: chains running concurrently do not
+    // interfere with each other.
+    int r0 = 0;
+    int r1 = 0;
+
+    std::thread a{[&r0] {
+        run_on_small_stack([&r0] {
+            chain_root graph{chain{50000}};
+            sync_execute(S{}, graph, [&r0](int r) { r0 = r; });
+        });
+    }};
+
+    std::thread b{[&r1] {
+        run_on_small_stack([&r1] {
+            chain_root graph{chain{70000}};
+            sync_execute(S{}, graph, [&r1](int r) { r1 = r; });
+        });
+    }};
+
+    a.join();
+    b.join();
+
+    EXPECT_EQ(r0, 50000);
+    EXPECT_EQ(r1, 70000);
+}
+
+void t3()
+{
+    // A chain whose continuation executes another chain synchronously: the
+    // nested execution cannot rely on the blocked outer frames to run its
+    // deferred continuations.
+    int inner = 0;
+    int outer = 0;
+
+    run_on_small_stack([&] {
+        chain_root graph{chain{100}};
+        sync_execute(inline_scheduler{}, graph, [&](int r) {
+            chain_root nested{chain{1000}};
+            sync_execute(
+                inline_scheduler{}, nested, [&inner](int x) { inner = x; });
+
+            outer = r;
+        });
+    });
+
+    EXPECT_EQ(inner, 1000);
+    EXPECT_EQ(outer, 100);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
@@ -0,0 +1,167 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <string>
+#include <thread>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+struct tally
+{
+    std::atomic<int> _hits[4]{};
+    std::atomic<int> _inside{0};
+    std::atomic<int> _overlaps{0};
+    std::atomic<int> _sum{0};
+
+    void reset()
+    {
+        for(auto& h : _hits)
+        {
+            h = 0;
+        }
+
+        _sum = 0;
+    }
+
+    void enter(std::size_t i, int x)
+    {
+        if(_inside.fetch_add(1) != 0)
+        {
+            ++_overlaps;
+        }
+
+        ++_hits[i];
+        _sum += x;
+        std::this_thread::yield();
+        --_inside;
+    }
+};
+
+template <typename Scheduler>
+void serialized_handlers(Scheduler&& s)
+{
+    tally t;
+
+    auto graph = when_each{
+        [&t](auto i, auto x) {
+            t.enter(i, static_cast<int>(x));
+        },
+        leaf{[] { return 1; }},                  //
+        leaf{[] { return 2u; }},                 //
+        leaf{[] { return 'a'; }},                //
+        seq{leaf{[] { return 3; }},              //
+            leaf{[](int x) { return x * 10; }}}}; //
+
+    for(int i = 0; i < 50; ++i)
+    {
+        t.reset();
+
+        sync_execute(s, graph, [&t] {
+            // Completion follows every handler invocation.
+            EXPECT_EQ(t._sum.load(), 1 + 2 + 'a' + 30);
+        });
+
+        for(auto& h : t._hits)
+        {
+            EXPECT_EQ(h.load(), 1);
+        }
+    }
+
+    EXPECT_EQ(t._overlaps.load(), 0);
+}
+
+void t0()
+{
+    serialized_handlers(S{});
+    serialized_handlers(inline_scheduler{});
+
+    thread_pool p{4};
+    serialized_handlers(p);
+}
+
+void t1()
+{
+    // Results are handled in completion order.
+    std::string order;
+
+    auto graph = when_each{
+        [&order](auto i, char c) {
+            EXPECT_EQ(static_cast<char>('a' + i), c);
+            order += c;
+        },
+        leaf{[] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(60));
+            return 'a';
+        }},
+        leaf{[] { return 'b'; }},
+        leaf{[] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            return 'c';
+        }}};
+
+    sync_execute(S{}, graph, [] {});
+    EXPECT_EQ(order, "bca");
+}
+
+void t2()
+{
+    // Concurrent handlers still report every child once before completion.
+    std::atomic<int> hits[3]{};
+
+    auto graph = when_each{concurrent,
+        [&hits](auto i, int) { ++hits[std::size_t(i)]; },
+        leaf{[] { return 0; }}, leaf{[] { return 1; }},
+        leaf{[] { return 2; }}};
+
+    thread_pool p{4};
+    for(int i = 1; i <= 50; ++i)
+    {
+        sync_execute(p, graph, [&hits, i] {
+            for(auto& h : hits)
+            {
+                EXPECT_EQ(h.load(), i);
+            }
+        });
+    }
+}
+
+void t3()
+{
+    // The input is forwarded to every child.
+    int sum = 0;
+
+    auto graph = seq{leaf{[] { return 5; }},
+        when_each{[&sum](auto, int x) { sum += x; },
+            leaf{[](int x) { return x + 1; }},
+            leaf{[](int x) { return x * 2; }}}};
+
+    sync_execute(S{}, graph, [] {});
+    EXPECT_EQ(sum, 16);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
@@ -0,0 +1,193 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::node;
+using namespace std::chrono_literals;
+using orizzonte::get;
+using orizzonte::scheduler::deadline_pool;
+using orizzonte::utility::sync_execute;
+
+auto make_graph(int x)
+{
+    return all{leaf{[x] { return x; }}, leaf{[] { return 2; }},
+        seq{leaf{[x] { return x; }}, leaf{[](int y) { return y + 1; }}}};
+}
+
+void t0()
+{
+    // Graphs complete, and meet a generous deadline.
+    deadline_pool p{4};
+    auto f = p.with_timeout(10s);
+
+    for(int i = 0; i < 10; ++i)
+    {
+        auto graph = make_graph(i);
+        sync_execute(f, graph, [i](auto r) {
+            EXPECT_EQ(get<0>(r), i);
+            EXPECT_EQ(get<2>(r), i + 1);
+        });
+    }
+
+    EXPECT_FALSE(f.missed());
+    EXPECT_FALSE(f.expired());
+}
+
+void t1()
+{
+    // Computations are started earliest-deadline-first.
+    std::vector<int> order;
+    std::atomic<bool> release{false};
+
+    {
+        deadline_pool p{1};
+        auto blocker = p.with_timeout(10s);
+        auto f1 = p.with_timeout(1s);
+        auto f2 = p.with_timeout(2s);
+        auto f3 = p.with_timeout(3s);
+
+        block(blocker, release);
+
+        f3([&] { order.push_back(3); });
+        f1([&] { order.push_back(1); });
+        f2([&] { order.push_back(2); });
+        f1([&] { order.push_back(1); });
+
+        release = true;
+    }
+
+    EXPECT_EQ(order.size(), 4u);
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 1);
+    EXPECT_EQ(order[2], 2);
+    EXPECT_EQ(order[3], 3);
+}
+
+void t2()
+{
+    // Late computations are demoted behind the ones that can be on time.
+    std::vector<int> order;
+    std::atomic<int> ran{0};
+    std::atomic<bool> release{false};
+
+    auto now = deadline_pool::clock::now();
+
+    {
+        deadline_pool p{1};
+        auto blocker = p.with_timeout(10s);
+        auto late = p.with_deadline(now - 1s);
+        auto on_time = p.with_timeout(10s);
+
+        block(blocker, release);
+
+        late([&] {
+            order.push_back(0);
+            ++ran;
+        });
+        on_time([&] {
+            order.push_back(1);
+            ++ran;
+        });
+
+        release = true;
+        while(ran != 2)
+        {
+            std::this_thread::yield();
+        }
+
+        EXPECT_TRUE(late.missed());
+        EXPECT_FALSE(on_time.missed());
+    }
+
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 0);
+}
+
+void t3()
+{
+    // Without demotion, late computations keep their place.
+    std::vector<int> order;
+    std::atomic<int> ran{0};
+    std::atomic<bool> release{false};
+
+    auto now = deadline_pool::clock::now();
+
+    {
+        deadline_pool p{1, false};
+        auto blocker = p.with_timeout(10s);
+        auto late = p.with_deadline(now - 1s);
+        auto on_time = p.with_timeout(10s);
+
+        block(blocker, release);
+
+        on_time([&] {
+            order.push_back(1);
+            ++ran;
+        });
+        late([&] {
+            order.push_back(0);
+            ++ran;
+        });
+
+        release = true;
+        while(ran != 2)
+        {
+            std::this_thread::yield();
+        }
+
+        EXPECT_TRUE(late.missed());
+    }
+
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+}
+
+void t4()
+{
+    // Concurrent clients with different deadlines, and work submitted from
+    // the workers themselves.
+    deadline_pool p{4};
+    std::atomic<int> done{0};
+    std::vector<std::thread> ts;
+
+    for(int t = 0; t < 4; ++t)
+    {
+        ts.emplace_back([&, t] {
+            for(int i = 0; i < 100; ++i)
+            {
+                auto graph = all{make_graph(i), make_graph(t)};
+                sync_execute(p.with_timeout(1ms * (i % 7)), graph,
+                    [&, i, t](auto r) {
+                        EXPECT_EQ(get<0>(get<0>(r)), i);
+                        EXPECT_EQ(get<2>(get<1>(r)), t + 1);
+                        ++done;
+                    });
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(done.load(), 400);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::fair_share_pool;
+using orizzonte::scheduler::traits;
+using orizzonte::utility::sync_execute;
+
+static_assert(traits<fair_share_pool::tenant_view&>::supports_bulk);
+static_assert(!traits<fair_share_pool>::is_single_threaded);
+
+auto make_graph()
+{
+    return all{leaf{[] { return 1; }}, leaf{[] { return 2; }},
+        seq{leaf{[] { return 3; }}, leaf{[](int x) { return x + 1; }}}};
+}
+
+void t0()
+{
+    // Graphs complete for every tenant.
+    fair_share_pool p{4, {1, 2, 3}};
+    EXPECT_EQ(p.tenant_count(), 3u);
+
+    for(std::size_t i = 0; i < p.tenant_count(); ++i)
+    {
+        EXPECT_EQ(p.tenant(i).id(), i);
+
+        auto graph = make_graph();
+        sync_execute(p.tenant(i), graph, [](auto r) {
+            EXPECT_EQ(get<0>(r), 1);
+            EXPECT_EQ(get<2>(r), 4);
+        });
+    }
+
+    auto graph = make_graph();
+    sync_execute(p, graph, [](auto r) { EXPECT_EQ(get<1>(r), 2); });
+}
+
+void t1()
+{
+    // Backlogged tenants are served proportionally to their weights.
+    std::vector<int> order;
+    std::atomic<bool> release{false};
+
+    {
+        fair_share_pool p{1, {1, 2, 1}};
+        block(p.tenant(2), release);
+
+        for(int i = 0; i < 6; ++i)
+        {
+            p.tenant(0)([&] { order.push_back(0); });
+            p.tenant(1)([&] { order.push_back(1); });
+        }
+
+        release = true;
+    }
+
+    EXPECT_EQ(order.size(), 12u);
+
+    int first_round = 0;
+    for(int i = 0; i < 6; ++i)
+    {
+        first_round += order[i];
+    }
+
+    EXPECT_EQ(first_round, 4);
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+    EXPECT_EQ(order[2], 1);
+}
+
+void t2()
+{
+    // A tenant flooding the pool does not prevent the others from making
+    // progress.
+    fair_share_pool p{2, {1, 1}};
+    std::atomic<bool> stop{false};
+
+    std::thread flooder{[&] {
+        while(!stop)
+        {
+            auto graph = all{make_graph(), make_graph(), make_graph()};
+            sync_execute(p.tenant(0), graph, [](auto&&) {});
+        }
+    }};
+
+    for(int i = 0; i < 50; ++i)
+    {
+        auto graph = make_graph();
+        sync_execute(p.tenant(1), graph, [](auto r) {
+            EXPECT_EQ(get<2>(r), 4);
+        });
+    }
+
+    stop = true;
+    flooder.join();
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+}
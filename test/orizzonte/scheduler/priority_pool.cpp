@@ -0,0 +1,165 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <mutex>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::priority_pool;
+using orizzonte::scheduler::traits;
+using orizzonte::utility::sync_execute;
+
+static_assert(traits<priority_pool>::supports_priority);
+static_assert(traits<priority_pool::view&>::supports_priority);
+static_assert(traits<priority_pool::view>::supports_bulk);
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+// Thread-per-task scheduler counting the submissions at every level.
+struct leveled
+{
+    static constexpr bool supports_priority = true;
+
+    std::atomic<int>* _counts;
+    leveled* _levels;
+    std::size_t _level;
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        ++_counts[_level];
+        std::thread{std::move(f)}.detach();
+    }
+
+    leveled& at(std::size_t level) const noexcept
+    {
+        return _levels[level];
+    }
+};
+
+auto make_graph()
+{
+    return all{leaf{[] { return 1; }}, leaf{[] { return 2; }},
+        seq{leaf{[] { return 3; }}, leaf{[](int x) { return x + 1; }}}};
+}
+
+void t0()
+{
+    // Graphs complete on the pool and on every level.
+    priority_pool p{4, 3};
+    EXPECT_EQ(p.levels(), 3u);
+
+    for(std::size_t l = 0; l < p.levels(); ++l)
+    {
+        EXPECT_EQ(p.at(l).level(), l);
+
+        auto graph = make_graph();
+        sync_execute(p.at(l), graph, [](auto r) {
+            EXPECT_EQ(get<0>(r), 1);
+            EXPECT_EQ(get<2>(r), 4);
+        });
+    }
+
+    auto graph = make_graph();
+    sync_execute(p, graph, [](auto r) { EXPECT_EQ(get<1>(r), 2); });
+}
+
+void t1()
+{
+    // More urgent levels are drained first.
+    std::vector<int> order;
+    std::atomic<bool> release{false};
+
+    {
+        priority_pool p{1, 3};
+        block(p.at(0), release);
+
+        p.at(2)([&] { order.push_back(2); });
+        p.at(1)([&] { order.push_back(1); });
+        p([&] { order.push_back(2); });
+        p.at(0)([&] { order.push_back(0); });
+
+        release = true;
+    }
+
+    EXPECT_EQ(order.size(), 4u);
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+    EXPECT_EQ(order[2], 2);
+    EXPECT_EQ(order[3], 2);
+}
+
+void t2()
+{
+    // A level passed over `starvation_limit` times is served anyway.
+    std::vector<int> order;
+    std::atomic<bool> release{false};
+
+    {
+        priority_pool p{1, 2, 3};
+        block(p.at(0), release);
+
+        p.at(1)([&] { order.push_back(1); });
+        for(int i = 0; i < 10; ++i)
+        {
+            p.at(0)([&] { order.push_back(0); });
+        }
+
+        release = true;
+    }
+
+    EXPECT_EQ(order.size(), 11u);
+    EXPECT_EQ(order[3], 1);
+}
+
+void t3()
+{
+    // `with_priority` moves the computations of its subgraph to its level.
+    std::atomic<int> counts[3]{};
+    leveled levels[3]{{counts, levels, 0}, {counts, levels, 1},
+        {counts, levels, 2}};
+
+    auto graph = all{leaf{[] { return 1; }}, leaf{[] { return 2; }},
+        with_priority{0, make_graph()}};
+
+    sync_execute(levels[2], graph, [](auto r) {
+        EXPECT_EQ(get<0>(get<2>(r)), 1);
+    });
+
+    EXPECT(counts[0].load() > 0);
+    EXPECT_EQ(counts[1].load(), 0);
+    EXPECT(counts[2].load() > 0);
+}
+
+void t4()
+{
+    // `with_priority` is transparent on other schedulers.
+    auto graph = seq{leaf{[] { return 1; }},
+        with_priority{0, leaf{[](int x) { return x * 2; }}}};
+
+    sync_execute(S{}, graph, [](int r) { EXPECT_EQ(r, 2); });
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+}
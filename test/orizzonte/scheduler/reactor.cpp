@@ -0,0 +1,235 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::reactor;
+using orizzonte::utility::sync_execute;
+
+struct socket_pair
+{
+    int _fds[2];
+
+    socket_pair()
+    {
+        EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, _fds), 0);
+    }
+
+    ~socket_pair()
+    {
+        ::close(_fds[0]);
+        ::close(_fds[1]);
+    }
+};
+
+void t0()
+{
+    // Computations are executed on the workers.
+    reactor r{2};
+
+    auto graph = all{leaf{[] { return 1; }}, leaf{[] { return 2; }}};
+    sync_execute(r, graph, [](auto x) {
+        EXPECT_EQ(get<0>(x), 1);
+        EXPECT_EQ(get<1>(x), 2);
+    });
+}
+
+void t1()
+{
+    // A pending read does not hold the only worker.
+    reactor r{1};
+    socket_pair p;
+    char buffer[8]{};
+
+    auto graph = all{io::read(r, p._fds[0], buffer, sizeof(buffer)),
+        seq{leaf{[] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }},
+            io::write(r, p._fds[1], "hi", 2)}};
+
+    sync_execute(r, graph, [](auto x) {
+        EXPECT_EQ(get<0>(x), 2);
+        EXPECT_EQ(get<1>(x), 2);
+    });
+
+    EXPECT(std::strcmp(buffer, "hi") == 0);
+}
+
+void t2()
+{
+    // Identical I/O leaves can be children of the same node.
+    reactor r{2};
+    socket_pair p0;
+    socket_pair p1;
+    char b0[4]{};
+    char b1[4]{};
+
+    auto graph = all{io::read(r, p0._fds[0], b0, 3),
+        io::read(r, p1._fds[0], b1, 3), io::write(r, p0._fds[1], "abc", 3),
+        io::write(r, p1._fds[1], "def", 3)};
+
+    sync_execute(r, graph, [](auto x) {
+        EXPECT_EQ(get<0>(x), 3);
+        EXPECT_EQ(get<1>(x), 3);
+    });
+
+    EXPECT(std::strcmp(b0, "abc") == 0);
+    EXPECT(std::strcmp(b1, "def") == 0);
+}
+
+void t3()
+{
+    // Writes larger than the socket buffer suspend until it is drained.
+    reactor r{2};
+    socket_pair p;
+
+    const std::size_t size = 8 * 1024 * 1024;
+    std::vector<char> data(size, 'x');
+
+    std::thread reader{[&p, size] {
+        std::size_t total = 0;
+        char chunk[64 * 1024];
+
+        while(total < size)
+        {
+            const auto n = ::read(p._fds[1], chunk, sizeof(chunk));
+            if(n > 0)
+            {
+                total += std::size_t(n);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    auto graph = io::write(r, p._fds[0], data.data(), size);
+    sync_execute(r, graph, [size](ssize_t n) { EXPECT_EQ(n, static_cast<ssize_t>(size)); });
+
+    reader.join();
+}
+
+void t4()
+{
+    // Loopback connection and echo.
+    reactor r{2};
+
+    const int listener =
+        ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+
+    socklen_t length = sizeof(address);
+    EXPECT_EQ(::bind(listener, reinterpret_cast<sockaddr*>(&address),
+                  sizeof(address)),
+        0);
+    EXPECT_EQ(::listen(listener, 16), 0);
+    ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+
+    int server = -1;
+    int client = -1;
+
+    auto connection = all{io::accept(r, listener), io::connect(r, address)};
+    sync_execute(r, connection, [&](auto x) {
+        server = get<0>(x);
+        client = get<1>(x);
+    });
+
+    EXPECT(server >= 0);
+    EXPECT(client >= 0);
+
+    char server_buffer[5]{};
+    char client_buffer[5]{};
+
+    auto echo = all{
+        seq{seq{io::write(r, client, "ping", 4),
+                leaf{[client](ssize_t) { return client; }}},
+            io::read_from(r, client_buffer, 4)},
+        seq{seq{io::read(r, server, server_buffer, 4),
+                leaf{[server](ssize_t) { return server; }}},
+            io::write_to(r, server_buffer, 4)}};
+
+    sync_execute(r, echo, [](auto x) {
+        EXPECT_EQ(get<0>(x), 4);
+        EXPECT_EQ(get<1>(x), 4);
+    });
+
+    EXPECT(std::strcmp(client_buffer, "ping") == 0);
+
+    ::close(server);
+    ::close(client);
+    ::close(listener);
+}
+
+void t5()
+{
+    // Errors are reported as `-errno`.
+    reactor r{1};
+    char buffer[1];
+
+    auto graph = io::read(r, -1, buffer, 1);
+    sync_execute(r, graph, [](ssize_t n) { EXPECT_EQ(n, -EBADF); });
+}
+
+void t6()
+{
+    // Computations still queued on the workers on destruction can wait on
+    // the reactor.
+    std::atomic<int> waits{0};
+    socket_pair p;
+
+    {
+        reactor r{1};
+        for(int i = 0; i < 16; ++i)
+        {
+            r([&r, &p, &waits] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                r.wait(p._fds[0], orizzonte::scheduler::interest::readable,
+                    [] {});
+
+                ++waits;
+            });
+        }
+    }
+
+    EXPECT_EQ(waits.load(), 16);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+    t5();
+    t6();
+}
+
+#else
+
+TEST_MAIN()
+{
+}
+
+#endif
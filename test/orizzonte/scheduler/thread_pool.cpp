@@ -0,0 +1,188 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::sync_execute;
+
+// Never spawns: every child is executed inline.
+struct saturated_scheduler
+{
+    int _scheduled{0};
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        ++_scheduled;
+        f();
+    }
+
+    bool should_spawn() const noexcept
+    {
+        return false;
+    }
+};
+
+void t0()
+{
+    std::atomic<int> i{0};
+
+    {
+        thread_pool p{4};
+        for(int j = 0; j < 100; ++j)
+        {
+            p([&i] { ++i; });
+        }
+    }
+
+    EXPECT_EQ(i.load(), 100);
+}
+
+void t1()
+{
+    thread_pool p{4};
+
+    auto graph = all{
+        leaf{[] { return 0; }}, //
+        leaf{[] { return 1; }}, //
+        seq{
+            leaf{[] { return 1; }},           //
+            leaf{[](int x) { return x + 1; }} //
+        }                                     //
+    };
+
+    sync_execute(p, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 0);
+        EXPECT_EQ(get<1>(r), 1);
+        EXPECT_EQ(get<2>(r), 2);
+    });
+}
+
+void t2()
+{
+    // A pool whose only worker is busy does not want new computations.
+    thread_pool p{1};
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+
+    while(!p.should_spawn())
+    {
+        std::this_thread::yield();
+    }
+
+    p([&] {
+        started = true;
+        while(!release)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    while(!started)
+    {
+        std::this_thread::yield();
+    }
+
+    EXPECT_FALSE(p.should_spawn());
+    EXPECT_FALSE(orizzonte::scheduler::should_spawn(p));
+    release = true;
+}
+
+void t3()
+{
+    // Children are executed inline when the scheduler is saturated.
+    saturated_scheduler s;
+
+    auto graph = all{
+        leaf{[] { return 0; }}, //
+        leaf{[] { return 1; }}, //
+        any{
+            leaf{[] { return 2; }}, //
+            leaf{[] { return 3; }}  //
+        }                           //
+    };
+
+    sync_execute(s, graph, [](auto r) {
+        EXPECT_EQ(get<0>(r), 0);
+        EXPECT_EQ(get<1>(r), 1);
+    });
+
+    EXPECT_EQ(s._scheduled, 0);
+}
+
+void t4()
+{
+    // Schedulers without `should_spawn` always spawn.
+    struct S
+    {
+        void operator()(...)
+        {
+        }
+    } s;
+
+    EXPECT_TRUE(orizzonte::scheduler::should_spawn(s));
+}
+
+void t5()
+{
+    // Every index of a bulk submission is executed exactly once.
+    std::atomic<int> hits[16]{};
+
+    {
+        thread_pool p{4};
+        for(int j = 0; j < 100; ++j)
+        {
+            p.bulk(16, [&hits](std::size_t i) { ++hits[i]; });
+        }
+
+        p.bulk(0, [](std::size_t) { EXPECT(false); });
+    }
+
+    for(auto& h : hits)
+    {
+        EXPECT_EQ(h.load(), 100);
+    }
+}
+
+void t6()
+{
+    // Wide `all` nodes are submitted in bulk.
+    static_assert(orizzonte::scheduler::traits<thread_pool>::supports_bulk);
+    thread_pool p{4};
+
+    for(int j = 0; j < 100; ++j)
+    {
+        auto graph = all{
+            leaf{[] { return 0; }}, leaf{[] { return 1; }}, //
+            leaf{[] { return 2; }}, leaf{[] { return 3; }}, //
+            leaf{[] { return 4; }}, leaf{[] { return 5; }}  //
+        };
+
+        sync_execute(p, graph, [](auto r) {
+            EXPECT_EQ(get<0>(r), 0);
+            EXPECT_EQ(get<3>(r), 3);
+            EXPECT_EQ(get<5>(r), 5);
+        });
+    }
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+    t5();
+    t6();
+}
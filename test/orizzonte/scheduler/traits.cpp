@@ -0,0 +1,142 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <thread>
+
+using namespace orizzonte::node;
+using orizzonte::get;
+using orizzonte::scheduler::event_loop;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::scheduler::traits;
+using orizzonte::utility::sync_execute;
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+struct bulk_priority_scheduler
+{
+    static constexpr bool supports_priority = true;
+
+    template <typename F>
+    void operator()(F&& f)
+    {
+        f();
+    }
+
+    template <typename F>
+    void bulk(std::size_t n, F&& f)
+    {
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            f();
+        }
+    }
+};
+
+static_assert(!traits<S>::is_inline);
+static_assert(!traits<S>::is_single_threaded);
+static_assert(!traits<S>::supports_bulk);
+static_assert(!traits<S>::supports_priority);
+
+static_assert(traits<inline_scheduler>::is_inline);
+static_assert(traits<const inline_scheduler&>::is_single_threaded);
+
+static_assert(!traits<event_loop>::is_inline);
+static_assert(traits<event_loop&>::is_single_threaded);
+
+static_assert(!traits<thread_pool>::is_single_threaded);
+
+static_assert(traits<bulk_priority_scheduler>::supports_bulk);
+static_assert(traits<bulk_priority_scheduler>::supports_priority);
+
+auto make_graph()
+{
+    return all{leaf{[] { return 1; }}, leaf{[] { return 2; }},
+        any{leaf{[] { return 3; }}, leaf{[] { return 3.0f; }}}};
+}
+
+template <typename Scheduler>
+void check_graph(Scheduler&& s)
+{
+    int calls = 0;
+    auto graph = make_graph();
+
+    sync_execute(s, graph, [&calls](auto r) {
+        EXPECT_EQ(get<0>(r), 1);
+        EXPECT_EQ(get<1>(r), 2);
+        ++calls;
+    });
+
+    EXPECT_EQ(calls, 1);
+}
+
+void t1()
+{
+    // Plain counters and no latch.
+    check_graph(inline_scheduler{});
+}
+
+void t2()
+{
+    // Plain counters, driven by `event_loop::run()`.
+    event_loop l;
+    check_graph(l);
+}
+
+void t3()
+{
+    // Atomic counters and latch.
+    check_graph(S{});
+}
+
+void t4()
+{
+    event_loop l;
+    int order = 0;
+    int first = -1;
+    int second = -1;
+
+    l([&] {
+        first = order++;
+        l([&] { second = order++; });
+    });
+
+    EXPECT_EQ(order, 0);
+    l.run();
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, 1);
+}
+
+void t5()
+{
+    orizzonte::utility::maybe_atomic<int> a;
+    a.store<true>(2);
+    EXPECT_EQ(a.fetch_sub<true>(1), 2);
+    EXPECT_EQ(a.fetch_sub<true>(1), 1);
+
+    orizzonte::utility::maybe_atomic<int> p;
+    p.store<false>(2);
+    EXPECT_EQ(p.fetch_sub<false>(1), 2);
+    EXPECT_EQ(p.fetch_sub<false>(1), 1);
+}
+
+TEST_MAIN()
+{
+    t1();
+    t2();
+    t3();
+    t4();
+    t5();
+}
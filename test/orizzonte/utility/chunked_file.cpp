@@ -0,0 +1,123 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <orizzonte/utility/chunked_file.hpp>
+#include <orizzonte/utility/mapped_file.hpp>
+#include <string>
+#include <unistd.h>
+
+using namespace orizzonte::utility;
+
+// Concatenation of `chunks`.
+template <typename Chunks>
+std::string join(const Chunks& chunks)
+{
+    std::string result;
+    for(auto c : chunks)
+    {
+        result += c;
+    }
+
+    return result;
+}
+
+// Writes `contents` to a new temporary file and returns its path.
+std::string make_file(const std::string& contents)
+{
+    char path[] = "/tmp/orizzonte_chunked_file_XXXXXX";
+    const int fd = ::mkstemp(path);
+    EXPECT(fd >= 0);
+    const auto written = ::write(fd, contents.data(), contents.size());
+    EXPECT(written == ssize_t(contents.size()));
+    ::close(fd);
+    return path;
+}
+
+void t0()
+{
+    const std::string text = "aa\nbbbb\nc\ndddddd\ne";
+
+    // Chunks span at least 3 bytes and end right after a delimiter.
+    const auto chunks = split_chunks(text, 3);
+    EXPECT_EQ(chunks.size(), 4u);
+    EXPECT(chunks[0] == "aa\n");
+    EXPECT(chunks[1] == "bbbb\n");
+    EXPECT(chunks[2] == "c\ndddddd\n");
+    EXPECT(chunks[3] == "e");
+    EXPECT(join(chunks) == text);
+
+    // Chunks never reference copies.
+    EXPECT(chunks[0].data() == text.data());
+}
+
+void t1()
+{
+    EXPECT(split_chunks("", 4).empty());
+    EXPECT_EQ(split_chunks("abc", 100).size(), 1u);
+    EXPECT_EQ(split_chunks("abc", 0).size(), 1u);
+    EXPECT_EQ(split_chunks("a,b,c", 1, ',').size(), 3u);
+
+    for(std::size_t n = 1; n < 32; ++n)
+    {
+        const std::string text = "x\nyy\n\nzzz\nwwww\n";
+        EXPECT(join(split_chunks(text, n)) == text);
+    }
+}
+
+void t2()
+{
+    std::string contents;
+    for(int i = 0; i < 10000; ++i)
+    {
+        contents += std::to_string(i) + '\n';
+    }
+
+    const auto path = make_file(contents);
+
+    for(bool use_mmap : {true, false})
+    {
+        mapped_file f{path.c_str(), use_mmap};
+        EXPECT_EQ(f.error(), 0);
+        EXPECT_EQ(f.mapped(), use_mmap);
+        EXPECT(f.view() == contents);
+
+        chunked_file c{std::move(f), 1000};
+        EXPECT(c.size() > 1);
+        EXPECT(join(c) == contents);
+
+        // Moving the file does not invalidate the chunks.
+        chunked_file moved{std::move(c)};
+        EXPECT(join(moved) == contents);
+        EXPECT(moved[0].data() == moved.file().data());
+    }
+
+    ::unlink(path.c_str());
+}
+
+void t3()
+{
+    mapped_file f{"/nonexistent/orizzonte"};
+    EXPECT_EQ(f.error(), ENOENT);
+    EXPECT_EQ(f.size(), 0u);
+
+    chunked_file c{std::move(f), 16};
+    EXPECT_EQ(c.size(), 0u);
+
+    const auto path = make_file("");
+    mapped_file empty{path.c_str()};
+    EXPECT_EQ(empty.error(), 0);
+    EXPECT_EQ(empty.size(), 0u);
+    ::unlink(path.c_str());
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
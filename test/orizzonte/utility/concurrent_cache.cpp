@@ -0,0 +1,122 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <orizzonte/utility/concurrent_cache.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::utility;
+
+// Every entry weighs one byte.
+struct unit_weigher
+{
+    template <typename K, typename V>
+    std::size_t operator()(const K&, const V&) const noexcept
+    {
+        return 1;
+    }
+};
+
+void t0()
+{
+    // The least recently used entry is evicted.
+    concurrent_cache<int, std::string, lru_eviction, unit_weigher> c{3, 1};
+
+    c.insert(0, "a");
+    c.insert(1, "b");
+    c.insert(2, "c");
+    EXPECT_EQ(*c.find(0), "a");
+
+    c.insert(3, "d");
+    EXPECT_EQ(c.size(), 3u);
+    EXPECT_FALSE(c.find(1).has_value());
+    EXPECT_TRUE(c.find(0).has_value());
+    EXPECT_TRUE(c.find(3).has_value());
+
+    EXPECT_EQ(c.hits(), 3u);
+    EXPECT_EQ(c.misses(), 1u);
+}
+
+void t1()
+{
+    // Referenced entries get a second chance.
+    concurrent_cache<int, int, clock_eviction, unit_weigher> c{3, 1};
+
+    c.insert(0, 0);
+    c.insert(1, 10);
+    c.insert(2, 20);
+    EXPECT_EQ(*c.find(0), 0);
+    EXPECT_EQ(*c.find(2), 20);
+
+    c.insert(3, 30);
+    EXPECT_EQ(c.size(), 3u);
+    EXPECT_FALSE(c.find(1).has_value());
+    EXPECT_EQ(*c.find(0), 0);
+    EXPECT_EQ(*c.find(3), 30);
+}
+
+void t2()
+{
+    // The budget is expressed in bytes, and entries are never replaced.
+    concurrent_cache<int, long long> c{10 * (sizeof(int) + sizeof(long long)),
+        2};
+
+    for(int i = 0; i < 100; ++i)
+    {
+        c.insert(i, i);
+        c.insert(i, -1);
+    }
+
+    EXPECT(c.size() <= 10u);
+    EXPECT_EQ(*c.find(99), 99);
+}
+
+template <typename Policy>
+void concurrent_use()
+{
+    concurrent_cache<int, int, Policy, unit_weigher> c{64, 4};
+
+    std::vector<std::thread> ts;
+    for(int t = 0; t < 4; ++t)
+    {
+        ts.emplace_back([&c] {
+            for(int i = 0; i < 10000; ++i)
+            {
+                const int k = i % 128;
+                if(auto v = c.find(k); v)
+                {
+                    EXPECT_EQ(*v, k * 2);
+                }
+                else
+                {
+                    c.insert(k, k * 2);
+                }
+            }
+        });
+    }
+
+    for(auto& t : ts)
+    {
+        t.join();
+    }
+
+    EXPECT(c.size() <= 64u);
+    EXPECT_EQ(c.hits() + c.misses(), 40000u);
+}
+
+void t3()
+{
+    concurrent_use<lru_eviction>();
+    concurrent_use<clock_eviction>();
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <orizzonte/utility/eventcount.hpp>
+#include <orizzonte/utility/mpmc_queue.hpp>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::utility;
+
+void t0()
+{
+    // Notifying without waiters is a no-op. A cancelled wait does not block
+    // later ones.
+    eventcount ec;
+    ec.notify_one();
+    ec.notify_all();
+
+    ec.prepare_wait();
+    ec.cancel_wait();
+
+    std::atomic<bool> ready{false};
+    std::thread t{[&] {
+        ready = true;
+        ec.notify_one();
+    }};
+
+    while(true)
+    {
+        const auto key = ec.prepare_wait();
+        if(ready)
+        {
+            ec.cancel_wait();
+            break;
+        }
+
+        ec.wait(key);
+    }
+
+    t.join();
+}
+
+void t1()
+{
+    // Consumers park on an empty queue. No wakeup is lost: every element
+    // is consumed and every consumer terminates.
+    constexpr int consumers = 4;
+    constexpr int n = 100000;
+
+    mpmc_queue<int> q{8};
+    eventcount not_empty;
+    eventcount not_full;
+    std::atomic<int> received{0};
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> threads;
+
+    for(int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            while(true)
+            {
+                if(auto x = q.try_pop(); x)
+                {
+                    not_full.notify_one();
+                    if(*x < 0)
+                    {
+                        return;
+                    }
+
+                    sum += *x;
+                    ++received;
+                    continue;
+                }
+
+                const auto key = not_empty.prepare_wait();
+                if(auto x = q.try_pop(); x)
+                {
+                    not_empty.cancel_wait();
+                    not_full.notify_one();
+                    if(*x < 0)
+                    {
+                        return;
+                    }
+
+                    sum += *x;
+                    ++received;
+                    continue;
+                }
+
+                not_empty.wait(key);
+            }
+        });
+    }
+
+    auto push = [&](int x) {
+        while(!q.try_push(x))
+        {
+            const auto key = not_full.prepare_wait();
+            if(q.try_push(x))
+            {
+                not_full.cancel_wait();
+                break;
+            }
+
+            not_full.wait(key);
+        }
+
+        not_empty.notify_one();
+    };
+
+    for(int i = 0; i < n; ++i)
+    {
+        push(i);
+    }
+
+    for(int c = 0; c < consumers; ++c)
+    {
+        push(-1);
+    }
+
+    for(auto& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(received.load(), n);
+    EXPECT_EQ(sum.load(), (long long)n * (n - 1) / 2);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+}
@@ -0,0 +1,174 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <numeric>
+#include <orizzonte/node.hpp>
+#include <orizzonte/scheduler.hpp>
+#include <orizzonte/utility.hpp>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+struct S
+{
+    template <typename F>
+    void operator()(F&& f)
+    {
+        std::thread{std::move(f)}.detach();
+    }
+};
+
+using namespace orizzonte::node;
+using orizzonte::scheduler::event_loop;
+using orizzonte::scheduler::inline_scheduler;
+using orizzonte::scheduler::thread_pool;
+using orizzonte::utility::execute_batch;
+using orizzonte::utility::soa;
+
+std::vector<int> iota(int n)
+{
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+template <typename Scheduler>
+void squares(Scheduler&& s)
+{
+    auto graph = leaf{[](int x) { return x * x; }};
+
+    for(int n : {0, 1, 3, 1000})
+    {
+        const auto inputs = iota(n);
+        std::vector<int> outputs(n, -1);
+
+        execute_batch(s, graph, inputs, outputs);
+
+        for(int i = 0; i < n; ++i)
+        {
+            EXPECT_EQ(outputs[i], i * i);
+        }
+    }
+}
+
+void t0()
+{
+    squares(inline_scheduler{});
+    squares(S{});
+
+    thread_pool p{4};
+    squares(p);
+}
+
+void t1()
+{
+    // Tuples produced by the graph are scattered into columns.
+    auto graph = all{leaf{[](int x) { return x + 1; }},
+        leaf{[](int x) { return std::to_string(x); }}};
+
+    const auto inputs = iota(500);
+    soa<int, std::string> outputs(inputs.size());
+
+    thread_pool p{4};
+    execute_batch(p, graph, inputs, outputs);
+
+    EXPECT_EQ(outputs.size(), 500u);
+    for(int i = 0; i < 500; ++i)
+    {
+        EXPECT_EQ(outputs.column<0>()[i], i + 1);
+        EXPECT_EQ(outputs.column<1>()[i], std::to_string(i));
+    }
+}
+
+void t2()
+{
+    // Items whose graph completes asynchronously, with cleanups.
+    auto graph = any{async_leaf{in<int>, out<int>,
+                         [](int x, auto done) {
+                             std::thread{[x, done = std::move(done)]() mutable {
+                                 done(x * 2);
+                             }}.detach();
+                         }},
+        leaf{[](int x) { return x * 2; }}};
+
+    const auto inputs = iota(200);
+    std::vector<orizzonte::variant<int, int>> outputs(inputs.size());
+
+    thread_pool p{2};
+    execute_batch(p, graph, inputs, outputs);
+
+    for(int i = 0; i < 200; ++i)
+    {
+        const auto& r = outputs[i];
+        EXPECT_EQ(r.which() == 0 ? orizzonte::get<0>(r) : orizzonte::get<1>(r),
+            i * 2);
+    }
+}
+
+void t3()
+{
+    // Soa buffers can be filled from `std::tuple`s too.
+    soa<int, char> s{2};
+    s.store(1, std::tuple{5, 'x'});
+
+    EXPECT_EQ(s.column<0>()[1], 5);
+    EXPECT_EQ(s.column<1>()[1], 'x');
+    EXPECT_EQ(s.column<0>()[0], 0);
+}
+
+void t4()
+{
+    // Event loops are driven until asynchronous items complete.
+    auto graph = all{async_leaf{in<int>, out<int>,
+                         [](int x, auto done) {
+                             std::thread{[x, done = std::move(done)]() mutable {
+                                 done(x + 1);
+                             }}.detach();
+                         }},
+        leaf{[](int x) { return x * 2; }}};
+
+    const auto inputs = iota(50);
+    soa<int, int> outputs(inputs.size());
+
+    event_loop l;
+    execute_batch(l, graph, inputs, outputs);
+
+    for(int i = 0; i < 50; ++i)
+    {
+        EXPECT_EQ(outputs.column<0>()[i], i + 1);
+        EXPECT_EQ(outputs.column<1>()[i], i * 2);
+    }
+}
+
+void t5()
+{
+    // Boolean columns are written concurrently.
+    auto graph = all{leaf{[](int x) { return x % 3 == 0; }},
+        leaf{[](int x) { return x; }}};
+
+    const auto inputs = iota(1000);
+    soa<bool, int> outputs(inputs.size());
+
+    thread_pool p{4};
+    execute_batch(p, graph, inputs, outputs);
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(bool(outputs.column<0>()[i]), i % 3 == 0);
+        EXPECT_EQ(outputs.column<1>()[i], i);
+    }
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+    t4();
+    t5();
+}
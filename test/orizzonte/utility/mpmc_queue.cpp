@@ -0,0 +1,109 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <atomic>
+#include <memory>
+#include <orizzonte/utility/mpmc_queue.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace orizzonte::utility;
+
+void t0()
+{
+    mpmc_queue<std::string> q{1};
+    EXPECT_EQ(q.capacity(), 2u);
+
+    EXPECT_EQ(q.try_push("a"), true);
+    EXPECT_EQ(q.try_emplace(3, 'b'), true);
+    EXPECT_EQ(q.try_push("c"), false);
+
+    EXPECT_EQ(*q.try_pop(), "a");
+    EXPECT_EQ(*q.try_pop(), "bbb");
+    EXPECT_EQ(q.try_pop().has_value(), false);
+
+    // Wraps around.
+    for(int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(q.try_push(std::to_string(i)), true);
+        EXPECT_EQ(*q.try_pop(), std::to_string(i));
+    }
+}
+
+void t1()
+{
+    auto p = std::make_shared<int>(0);
+
+    {
+        mpmc_queue<std::shared_ptr<int>> q{4};
+        EXPECT_EQ(q.try_push(p), true);
+        EXPECT_EQ(q.try_push(p), true);
+        EXPECT_EQ(p.use_count(), 3);
+    }
+
+    EXPECT_EQ(p.use_count(), 1);
+}
+
+void t2()
+{
+    // Every element is received exactly once.
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int per_producer = 50000;
+
+    mpmc_queue<int> q{16};
+    std::vector<std::atomic<int>> hits(producers * per_producer);
+    std::atomic<int> received{0};
+    std::vector<std::thread> threads;
+
+    for(int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&q, p] {
+            for(int i = 0; i < per_producer; ++i)
+            {
+                while(!q.try_push(p * per_producer + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for(int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            while(received.load() < producers * per_producer)
+            {
+                if(auto x = q.try_pop(); x)
+                {
+                    ++hits[*x];
+                    ++received;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for(auto& t : threads)
+    {
+        t.join();
+    }
+
+    for(auto& h : hits)
+    {
+        EXPECT_EQ(h.load(), 1);
+    }
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <memory>
+#include <orizzonte/utility/spsc_queue.hpp>
+#include <thread>
+
+using namespace orizzonte::utility;
+
+static_assert(round_up_to_power_of_two(0) == 1);
+static_assert(round_up_to_power_of_two(1) == 1);
+static_assert(round_up_to_power_of_two(5) == 8);
+static_assert(round_up_to_power_of_two(64) == 64);
+
+void t0()
+{
+    spsc_queue<int> q{3};
+    EXPECT_EQ(q.capacity(), 4u);
+    EXPECT_EQ(q.try_pop().has_value(), false);
+
+    for(int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(q.try_push(i), true);
+    }
+
+    EXPECT_EQ(q.try_push(4), false);
+
+    for(int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(*q.try_pop(), i);
+    }
+
+    EXPECT_EQ(q.try_pop().has_value(), false);
+}
+
+void t1()
+{
+    // Elements left in the queue are destroyed with it.
+    auto p = std::make_shared<int>(0);
+
+    {
+        spsc_queue<std::shared_ptr<int>> q{4};
+        EXPECT_EQ(q.try_push(p), true);
+        EXPECT_EQ(q.try_push(p), true);
+        EXPECT_EQ(q.try_push(p), true);
+        q.try_pop();
+        EXPECT_EQ(p.use_count(), 3);
+    }
+
+    EXPECT_EQ(p.use_count(), 1);
+}
+
+void t2()
+{
+    // Elements are received in order across threads.
+    constexpr int n = 200000;
+    spsc_queue<int> q{64};
+
+    std::thread producer{[&q] {
+        for(int i = 0; i < n; ++i)
+        {
+            while(!q.try_push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    for(int i = 0; i < n;)
+    {
+        if(auto x = q.try_pop(); x)
+        {
+            EXPECT_EQ(*x, i);
+            ++i;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+}
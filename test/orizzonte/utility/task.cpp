@@ -0,0 +1,80 @@
+// Copyright (c) 2017 Vittorio Romeo
+// MIT License |  https://opensource.org/licenses/MIT
+// http://vittorioromeo.info | vittorio.romeo@outlook.com
+
+#include "../../test_utils.hpp"
+#include <memory>
+#include <orizzonte/utility/task.hpp>
+
+using namespace orizzonte::utility;
+
+void t0()
+{
+    task t;
+    EXPECT_FALSE(static_cast<bool>(t));
+
+    int i = 0;
+    t = task{[&i] { i = 42; }};
+    EXPECT_TRUE(static_cast<bool>(t));
+
+    t();
+    EXPECT_EQ(i, 42);
+}
+
+void t1()
+{
+    // Move-only callables are supported.
+    int i = 0;
+    task t{[&i, p = std::make_unique<int>(42)] { i = *p; }};
+
+    task t2{std::move(t)};
+    EXPECT_FALSE(static_cast<bool>(t));
+
+    t2();
+    EXPECT_EQ(i, 42);
+}
+
+void t2()
+{
+    // Callables larger than the inline buffer are stored on the heap.
+    struct big
+    {
+        char _data[task_buffer_size * 2];
+    };
+
+    auto counter = std::make_shared<int>(0);
+
+    {
+        task t{[counter, b = big{}] { *counter += sizeof(b._data); }};
+        EXPECT_EQ(counter.use_count(), 2);
+
+        task t2;
+        t2 = std::move(t);
+        t2();
+
+        EXPECT_EQ(*counter, static_cast<int>(task_buffer_size * 2));
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+void t3()
+{
+    // Destruction releases the stored callable.
+    auto counter = std::make_shared<int>(0);
+
+    {
+        task t{[counter] {}};
+        EXPECT_EQ(counter.use_count(), 2);
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST_MAIN()
+{
+    t0();
+    t1();
+    t2();
+    t3();
+}
@@ -4,11 +4,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <exception>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
 
 #ifndef FWD
@@ -203,3 +205,24 @@ struct move_only
     move_only(move_only&&) = default;
     move_only& operator=(move_only&&) = default;
 };
+
+// Occupies a worker of `scheduler` until `release` is set. Returns once the
+// worker is busy.
+template <typename Scheduler>
+void block(Scheduler&& scheduler, std::atomic<bool>& release)
+{
+    std::atomic<bool> started{false};
+
+    scheduler([&] {
+        started = true;
+        while(!release)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    while(!started)
+    {
+        std::this_thread::yield();
+    }
+}